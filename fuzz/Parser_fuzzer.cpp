@@ -8,6 +8,10 @@
 
 #include <ISOBMFF.hpp>        // for various
 #include <Parser.hpp> // for Parser
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
 
 
 // libfuzzer infra to test the fuzz target
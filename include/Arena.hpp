@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Arena.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ARENA_HPP
+#define ISOBMFF_ARENA_HPP
+
+#include <Macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ISOBMFF {
+/*!
+ * @class       Arena
+ * @abstract    Monotonic memory region for parsed boxes.
+ * @discussion  Memory is handed out from large chunks and is never
+ *              released individually: all of it is freed at once when
+ *              the arena is destroyed. With the ArenaAllocation parser
+ *              option, each parse creates an arena, and every box
+ *              allocated from it keeps it alive.
+ *              Allocating from an arena is not thread-safe; releasing
+ *              the objects allocated from it is.
+ */
+class ISOBMFF_EXPORT Arena {
+ public:
+  /*!
+   * @constant    DefaultChunkSize
+   * @abstract    Default size of the chunks reserved by an arena (64 KiB).
+   */
+  static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+  class Scope;
+  class Object;
+
+  template <typename T>
+  class Allocator;
+
+  Arena(size_t chunkSize = DefaultChunkSize);
+  ~Arena();
+
+  Arena(const Arena& o) = delete;
+  Arena(Arena&& o) = delete;
+  Arena& operator=(const Arena& o) = delete;
+  Arena& operator=(Arena&& o) = delete;
+
+  /*!
+   * @function    Create
+   * @abstract    Creates a shared arena.
+   * @discussion  The arena is destroyed once the returned pointer and all
+   *              memory obtained through an Allocator are released.
+   * @param       chunkSize   The size of the chunks to reserve.
+   * @result      The arena.
+   */
+  static std::shared_ptr<Arena> Create(size_t chunkSize = DefaultChunkSize);
+
+  /*!
+   * @function    Allocate
+   * @abstract    Allocates memory from the arena.
+   * @param       size        The number of bytes.
+   * @param       alignment   The alignment (a power of two).
+   * @result      The allocated memory.
+   */
+  void* Allocate(size_t size, size_t alignment);
+
+  /*!
+   * @function    GetAllocatedSize
+   * @abstract    Gets the number of bytes allocated from the arena.
+   * @result      The number of bytes, including alignment padding.
+   */
+  size_t GetAllocatedSize() const;
+
+  /*!
+   * @function    GetReservedSize
+   * @abstract    Gets the number of bytes reserved by the arena.
+   * @result      The total size of the chunks.
+   */
+  size_t GetReservedSize() const;
+
+  /*!
+   * @function    GetCurrent
+   * @abstract    Gets the arena used by Object allocations on this thread.
+   * @result      The current arena, or nullptr.
+   * @see         Scope
+   */
+  static Arena* GetCurrent();
+
+ private:
+  class IMPL;
+
+  void Retain();
+  void Release();
+
+  std::unique_ptr<IMPL> impl;
+};
+
+/*!
+ * @class       Arena::Scope
+ * @abstract    Makes an arena current on this thread, while in scope.
+ */
+class ISOBMFF_EXPORT Arena::Scope {
+ public:
+  Scope(Arena* arena);
+  ~Scope();
+
+  Scope(const Scope& o) = delete;
+  Scope& operator=(const Scope& o) = delete;
+
+ private:
+  Arena* _previous;
+};
+
+/*!
+ * @class       Arena::Object
+ * @abstract    Base class for objects allocated from the current arena.
+ * @discussion  Objects created with `new` while an arena is current are
+ *              allocated from it, and keep it alive until they are
+ *              deleted, so they may be moved out of the boxes allocated
+ *              with them. Deleting them releases the arena, not their
+ *              memory. Other objects are allocated on the heap, as
+ *              usual. Objects must not outlive arenas that were not
+ *              obtained with Create.
+ */
+class ISOBMFF_EXPORT Arena::Object {
+ public:
+  static void* operator new(std::size_t size);
+  static void operator delete(void* p) noexcept;
+};
+
+/*!
+ * @class       Arena::Allocator
+ * @abstract    Standard allocator backed by an arena.
+ * @discussion  Suitable for `std::allocate_shared`: each allocation
+ *              keeps a shared arena alive until it is deallocated, so
+ *              copying the allocator itself is free.
+ */
+template <typename T>
+class Arena::Allocator {
+ public:
+  typedef T value_type;
+
+  Allocator(Arena* arena) : _arena(arena) {}
+
+  template <typename U>
+  Allocator(const Allocator<U>& o) : _arena(o.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    void* p = this->_arena->Allocate(n * sizeof(T), alignof(T));
+
+    this->_arena->Retain();
+
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    (void)p;
+    (void)n;
+
+    this->_arena->Release();
+  }
+
+  Arena* GetArena() const { return this->_arena; }
+
+  template <typename U>
+  bool operator==(const Allocator<U>& o) const {
+    return this->_arena == o.GetArena();
+  }
+
+  template <typename U>
+  bool operator!=(const Allocator<U>& o) const {
+    return this->_arena != o.GetArena();
+  }
+
+ private:
+  Arena* _arena;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_ARENA_HPP */
@@ -43,6 +43,16 @@ class ISOBMFF_EXPORT BinaryDataStream : public BinaryStream {
  public:
   BinaryDataStream();
   BinaryDataStream(const std::vector<uint8_t>& data);
+
+  /*!
+   * @function    BinaryDataStream
+   * @abstract    Creates a stream over borrowed bytes.
+   * @param       data    The data bytes.
+   * @param       size    The number of bytes.
+   * @discussion  The bytes are not copied, so they must outlive the
+   *              stream and any copy of it.
+   */
+  BinaryDataStream(const uint8_t* data, size_t size);
   BinaryDataStream(const BinaryDataStream& o);
   BinaryDataStream(BinaryDataStream&& o) noexcept;
 
@@ -53,8 +63,12 @@ class ISOBMFF_EXPORT BinaryDataStream : public BinaryStream {
   using BinaryStream::Read;
 
   Error Read(uint8_t* buf, size_t size) override;
+  Error ReadAt(uint64_t offset, uint8_t* buf, size_t size) const override;
+  bool IsReadAtThreadSafe() const override;
+  const uint8_t* GetBytes() const override;
   Error Seek(std::streamoff offset, SeekDirection dir) override;
   size_t Tell() const override;
+  size_t Size() const override;
 
   ISOBMFF_EXPORT friend void swap(BinaryDataStream& o1, BinaryDataStream& o2);
 
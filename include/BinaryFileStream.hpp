@@ -39,9 +39,29 @@
 #include <string>
 
 namespace ISOBMFF {
+/*!
+ * @class       BinaryFileStream
+ * @abstract    Binary stream reading a file through a read-ahead buffer.
+ * @discussion  Small reads are served from an in-memory buffer that is
+ *              refilled with a single read of the underlying file, so
+ *              parsing box headers does not issue one system call per
+ *              field. Seeks within the buffered range (backward or
+ *              forward) keep the buffer. Reads larger than the buffer
+ *              go straight to the file.
+ *              All reads are positional (pread), so `ReadAt` can be
+ *              called from several threads at once. It bypasses the
+ *              read-ahead buffer, which belongs to the stream cursor.
+ */
 class ISOBMFF_EXPORT BinaryFileStream : public BinaryStream {
  public:
-  BinaryFileStream(const std::string& path);
+  /*!
+   * @constant    DefaultBufferSize
+   * @abstract    Default size of the read-ahead buffer (64 KiB).
+   */
+  static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+  BinaryFileStream(const std::string& path,
+                   size_t bufferSize = DefaultBufferSize);
 
   virtual ~BinaryFileStream() override;
 
@@ -53,8 +73,32 @@ class ISOBMFF_EXPORT BinaryFileStream : public BinaryStream {
   using BinaryStream::Read;
 
   Error Read(uint8_t* buf, size_t size) override;
+  Error ReadAt(uint64_t offset, uint8_t* buf, size_t size) const override;
+  bool IsReadAtThreadSafe() const override;
   Error Seek(std::streamoff offset, SeekDirection dir) override;
   size_t Tell() const override;
+  size_t Size() const override;
+
+  /*!
+   * @function    GetBufferSize
+   * @abstract    Gets the size of the read-ahead buffer.
+   * @result      The buffer size, in bytes (0 if reads are unbuffered).
+   */
+  size_t GetBufferSize() const;
+
+  /*!
+   * @function    GetBytesRead
+   * @abstract    Gets the number of bytes read from the underlying file.
+   * @result      The number of bytes read, including read-ahead.
+   */
+  uint64_t GetBytesRead() const;
+
+  /*!
+   * @function    GetReadCount
+   * @abstract    Gets the number of reads issued to the underlying file.
+   * @result      The number of read system calls.
+   */
+  uint64_t GetReadCount() const;
 
  private:
   class IMPL;
@@ -48,7 +48,19 @@ class ISOBMFF_EXPORT BinaryStream {
   virtual ~BinaryStream() = default;
 
   virtual Error Read(uint8_t* buf, size_t size) = 0;
+  // seeks, reads and seeks back unless overridden, so the default moves
+  // the cursor of a const stream and is not safe against any concurrent
+  // ReadAt, Read or Seek on the same stream
+  virtual Error ReadAt(uint64_t offset, uint8_t* buf, size_t size) const;
+  // whether ReadAt can be called from several threads at once, without
+  // touching the cursor; false unless overridden
+  virtual bool IsReadAtThreadSafe() const;
+  // the bytes of the stream, when all of them are held in memory, or
+  // nullptr; nullptr unless overridden
+  virtual const uint8_t* GetBytes() const;
   virtual size_t Tell() const = 0;
+  // seeks to the end and back unless overridden
+  virtual size_t Size() const;
   virtual Error Seek(std::streamoff offset, SeekDirection dir) = 0;
 
   bool HasBytesAvailable();
@@ -95,6 +107,10 @@ class ISOBMFF_EXPORT BinaryStream {
   Error ReadLittleEndianUInt32(uint32_t& value);
   Error ReadBigEndianInt32(int32_t& value);
 
+  Error ReadBigEndianUInt16Array(uint16_t* values, size_t count);
+  Error ReadBigEndianUInt32Array(uint32_t* values, size_t count);
+  Error ReadBigEndianUInt64Array(uint64_t* values, size_t count);
+
   Error ReadUInt64(uint64_t& value);
   Error ReadBigEndianUInt64(uint64_t& value);
   Error ReadLittleEndianUInt64(uint64_t& value);
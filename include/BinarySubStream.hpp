@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BinarySubStream.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BINARY_SUB_STREAM_HPP
+#define ISOBMFF_BINARY_SUB_STREAM_HPP
+
+#include <BinaryStream.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace ISOBMFF {
+/*!
+ * @class       BinarySubStream
+ * @abstract    Bounded window over another binary stream.
+ * @discussion  The window starts at `offset` in the source stream and
+ *              spans `length` bytes. Reads are forwarded to the source
+ *              stream, so no data is copied. Windows over windows are
+ *              flattened onto the outermost source stream, so reading
+ *              from a deeply nested window costs the same as reading
+ *              from a top-level one.
+ *              The source stream must outlive the window.
+ */
+class ISOBMFF_EXPORT BinarySubStream : public BinaryStream {
+ public:
+  BinarySubStream(BinaryStream& stream, size_t offset, size_t length);
+
+  virtual ~BinarySubStream() override;
+
+  BinarySubStream(const BinarySubStream& o) = delete;
+  BinarySubStream(BinarySubStream&& o) = delete;
+  BinarySubStream& operator=(const BinarySubStream& o) = delete;
+  BinarySubStream& operator=(BinarySubStream&& o) = delete;
+
+  using BinaryStream::Read;
+
+  Error Read(uint8_t* buf, size_t size) override;
+  Error ReadAt(uint64_t offset, uint8_t* buf, size_t size) const override;
+  bool IsReadAtThreadSafe() const override;
+  const uint8_t* GetBytes() const override;
+  Error Seek(std::streamoff offset, SeekDirection dir) override;
+  size_t Tell() const override;
+  size_t Size() const override;
+
+  /*!
+   * @function    GetSource
+   * @abstract    Gets the stream the window reads from.
+   * @result      The outermost source stream.
+   */
+  BinaryStream& GetSource() const;
+
+  /*!
+   * @function    GetOffset
+   * @abstract    Gets the window offset.
+   * @result      The window offset, in the outermost source stream.
+   */
+  size_t GetOffset() const;
+
+  /*!
+   * @function    GetLength
+   * @abstract    Gets the window length.
+   * @result      The window length, in bytes.
+   */
+  size_t GetLength() const;
+
+ private:
+  class IMPL;
+
+  std::unique_ptr<IMPL> impl;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_BINARY_SUB_STREAM_HPP */
@@ -36,6 +36,7 @@
 #include <Error.hpp>
 #include <Macros.hpp>
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -118,6 +119,87 @@ class ISOBMFF_EXPORT Box : public DisplayableObject {
    */
   virtual std::vector<uint8_t> GetData() const;
 
+  /*!
+   * @function    GetOffset
+   * @abstract    Gets the position of the box in the file.
+   * @result      The offset of the box header, in bytes from the start of
+   *              the outermost stream it was parsed from.
+   * @discussion  Only set for boxes read by a parser, 0 otherwise.
+   */
+  uint64_t GetOffset() const;
+
+  /*!
+   * @function    GetHeaderSize
+   * @abstract    Gets the size of the box header.
+   * @result      The size of the size and type fields, including the
+   *              64-bit size when present (8 or 16 bytes).
+   * @discussion  Only set for boxes read by a parser, 0 otherwise.
+   */
+  uint64_t GetHeaderSize() const;
+
+  /*!
+   * @function    GetSize
+   * @abstract    Gets the size of the box.
+   * @result      The size of the box, header included.
+   * @discussion  Only set for boxes read by a parser, 0 otherwise.
+   */
+  uint64_t GetSize() const;
+
+  /*!
+   * @function    SetOffset
+   * @abstract    Sets the position of the box in the file.
+   * @param       value   The offset of the box header.
+   */
+  void SetOffset(uint64_t value);
+
+  /*!
+   * @function    SetHeaderSize
+   * @abstract    Sets the size of the box header.
+   * @param       value   The size of the box header.
+   */
+  void SetHeaderSize(uint64_t value);
+
+  /*!
+   * @function    SetSize
+   * @abstract    Sets the size of the box.
+   * @param       value   The size of the box, header included.
+   */
+  void SetSize(uint64_t value);
+
+  /*!
+   * @function    Defer
+   * @abstract    Defers reading the box data until it is first needed.
+   * @param       loader  A lambda reading the box data.
+   * @discussion  Used by the parser when the LazyDecoding option is set.
+   * @see         Parser::DeferBox
+   */
+  void Defer(const std::function<Error(Box&)>& loader);
+
+  /*!
+   * @function    IsLoaded
+   * @abstract    Checks whether the box data has been read.
+   * @result      false if reading the box data was deferred and has not
+   *              happened yet, or has failed, otherwise true.
+   */
+  bool IsLoaded() const;
+
+  /*!
+   * @function    Load
+   * @abstract    Reads the box data, if reading it was deferred.
+   * @result      Error if read fails, success otherwise.
+   * @discussion  Containers load boxes when they are accessed by name,
+   *              and when they are described. Boxes obtained through
+   *              GetBoxes() must be loaded explicitly before accessing
+   *              their contents. Reading is only attempted once: after
+   *              a failure, the box stays unloaded, its contents are
+   *              incomplete, and Load() keeps returning the error.
+   *              Loading is not thread-safe. The boxes of a parse share
+   *              the parser and the arena (see Parser::Options) they
+   *              are read with, so they must not be loaded from several
+   *              threads at once, even when they are different boxes.
+   */
+  Error Load();
+
   /*!
    * @function    swap
    * @abstract    Swap two objects.
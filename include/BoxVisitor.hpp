@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BoxVisitor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BOX_VISITOR_HPP
+#define ISOBMFF_BOX_VISITOR_HPP
+
+#include <Box.hpp>
+#include <Macros.hpp>
+#include <Parser.hpp>
+#include <memory>
+
+namespace ISOBMFF {
+/*!
+ * @class       BoxVisitor
+ * @abstract    Receives the boxes of a file while it is parsed.
+ * @discussion  Used with Parser::Parse, as an alternative to building
+ *              the box tree. Each box is entered, then either its
+ *              children are visited (for container boxes) or it is
+ *              decoded, and it is finally exited. Decoded boxes are
+ *              released after being visited, unless the visitor keeps
+ *              them, so memory use does not depend on the file size.
+ *              Each method returns what the parser should do next.
+ *              By default, all boxes are visited.
+ */
+class ISOBMFF_EXPORT BoxVisitor {
+ public:
+  /*!
+   * @enum        Action
+   * @abstract    What to do after visiting a box.
+   * @constant    Continue    Go on parsing.
+   * @constant    Skip        Skip the box entered, without decoding it
+   *                          or visiting its children. It is not exited.
+   *                          Same as Continue for other events.
+   * @constant    Stop        Stop parsing. This is not an error.
+   */
+  enum class Action : int { Continue, Skip, Stop };
+
+  BoxVisitor() = default;
+  BoxVisitor(const BoxVisitor&) = default;
+  BoxVisitor& operator=(const BoxVisitor&) = default;
+
+  /*!
+   * @function    ~BoxVisitor
+   * @abstract    Destructor.
+   */
+  virtual ~BoxVisitor();
+
+  /*!
+   * @function    EnterBox
+   * @abstract    Called when a box is found, before it is read.
+   * @param       entry   The box location. Its path includes the box.
+   * @result      What to do next.
+   */
+  virtual Action EnterBox(const Parser::BoxMapEntry& entry);
+
+  /*!
+   * @function    VisitBox
+   * @abstract    Called when a box which is not a container is decoded.
+   * @param       box     The decoded box.
+   * @result      What to do next.
+   * @discussion  MDAT data is only read with the DoNotSkipMDATData
+   *              parser option.
+   */
+  virtual Action VisitBox(const std::shared_ptr<Box>& box);
+
+  /*!
+   * @function    ExitBox
+   * @abstract    Called once a box and its children have been visited.
+   * @param       entry   The box location.
+   * @result      What to do next.
+   */
+  virtual Action ExitBox(const Parser::BoxMapEntry& entry);
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_BOX_VISITOR_HPP */
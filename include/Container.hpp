@@ -45,10 +45,14 @@ class ISOBMFF_EXPORT Container {
   virtual ~Container();
 
   virtual void AddBox(std::shared_ptr<Box> box) = 0;
+
+  // boxes whose reading was deferred are returned unloaded (see Box::Load)
   virtual std::vector<std::shared_ptr<Box> > GetBoxes() const = 0;
 
   void WriteBoxes(std::ostream& os, std::size_t indentLevel) const;
 
+  // boxes are loaded first; a box that fails to load is still returned,
+  // unloaded, and Box::Load() gives the error
   std::vector<std::shared_ptr<Box> > GetBoxes(const std::string& name) const;
   std::shared_ptr<Box> GetBox(const std::string& name) const;
 
@@ -35,13 +35,19 @@
 #include <AVC1.hpp>
 #include <AVC3.hpp>
 #include <AVCC.hpp>
+#include <Arena.hpp>
 #include <BinaryDataStream.hpp>
 #include <BinaryFileStream.hpp>
+#include <BinaryMappedFileStream.hpp>
 #include <BinaryStream.hpp>
+#include <BinarySubStream.hpp>
 #include <Box.hpp>
+#include <BoxVisitor.hpp>
 #include <CDSC.hpp>
+#include <CO64.hpp>
 #include <COLR.hpp>
 #include <CTTS.hpp>
+#include <ChunkOffsets.hpp>
 #include <Container.hpp>
 #include <ContainerBox.hpp>
 #include <DIMG.hpp>
@@ -65,6 +71,7 @@
 #include <IROT.hpp>
 #include <ISPE.hpp>
 #include <ImageGrid.hpp>
+#include <IncrementalParser.hpp>
 #include <MDHD.hpp>
 #include <META.hpp>
 #include <MP4A.hpp>
@@ -73,14 +80,22 @@
 #include <Matrix.hpp>
 #include <PITM.hpp>
 #include <PIXI.hpp>
+#include <ParseContext.hpp>
 #include <Parser.hpp>
+#include <ParserPool.hpp>
 #include <SCHM.hpp>
+#include <STCO.hpp>
+#include <STSC.hpp>
 #include <STSD.hpp>
 #include <STSS.hpp>
+#include <STSZ.hpp>
 #include <STTS.hpp>
+#include <STZ2.hpp>
+#include <SampleTable.hpp>
 #include <SingleItemTypeReferenceBox.hpp>
 #include <THMB.hpp>
 #include <TKHD.hpp>
+#include <ThreadPool.hpp>
 #include <URL.hpp>
 #include <URN.hpp>
 #include <Utils.hpp>
@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      IncrementalParser.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_INCREMENTAL_PARSER_HPP
+#define ISOBMFF_INCREMENTAL_PARSER_HPP
+
+#include <Box.hpp>
+#include <Error.hpp>
+#include <File.hpp>
+#include <Macros.hpp>
+#include <Parser.hpp>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <vector>
+
+namespace ISOBMFF {
+/*!
+ * @class       IncrementalParser
+ * @abstract    Parses a file as its data arrives.
+ * @discussion  Data is appended in chunks of any size, for instance as
+ *              it is received or written. Top-level boxes are decoded
+ *              as soon as all their data is there, and are added to the
+ *              file; the data of an incomplete box is kept until the
+ *              next chunks complete it. MDAT boxes, and boxes filtered
+ *              out by the parser's box paths, are not kept in memory.
+ *              A box with a size of 0 extends to the end of the data.
+ */
+class ISOBMFF_EXPORT IncrementalParser {
+ public:
+  /*!
+   * @constant    ChunkSize
+   * @abstract    Size of the chunks read from streams (64 KiB).
+   */
+  static constexpr size_t ChunkSize = 64 * 1024;
+
+  /*!
+   * @typedef     BoxHandler
+   * @abstract    Called with each top-level box, once decoded.
+   */
+  typedef std::function<void(const std::shared_ptr<Box>&)> BoxHandler;
+
+  /*!
+   * @function    IncrementalParser
+   * @abstract    Default constructor.
+   */
+  IncrementalParser();
+
+  /*!
+   * @function    IncrementalParser
+   * @abstract    Creates a parser that reads boxes like another one.
+   * @discussion  The options, box registrations and box path filters
+   *              of the parser are used. Boxes are never decoded lazily.
+   * @param       parser  The parser to copy.
+   */
+  explicit IncrementalParser(const Parser& parser);
+
+  IncrementalParser(const IncrementalParser& o);
+  IncrementalParser(IncrementalParser&& o) noexcept;
+  virtual ~IncrementalParser();
+
+  IncrementalParser& operator=(IncrementalParser o);
+
+  /*!
+   * @function    Append
+   * @abstract    Parses the next bytes of the file.
+   * @discussion  The bytes are copied if they do not complete a box.
+   *              Once an error is returned, it is returned again by all
+   *              following calls, until Reset is called.
+   * @param       data    The data bytes.
+   * @param       size    The number of bytes.
+   * @result      Error if parsing fails, success otherwise.
+   */
+  Error Append(const uint8_t* data, size_t size);
+
+  /*!
+   * @function    Append
+   * @abstract    Parses the next bytes of the file.
+   * @param       data    The data bytes.
+   * @result      Error if parsing fails, success otherwise.
+   * @see         Append(const uint8_t*, size_t)
+   */
+  Error Append(const std::vector<uint8_t>& data);
+
+  /*!
+   * @function    Append
+   * @abstract    Parses the rest of a stream.
+   * @discussion  The stream is read forward only, up to its end, so it
+   *              may be a pipe or a socket. MDAT data is read and
+   *              discarded, instead of being skipped with a seek.
+   * @param       stream  The stream.
+   * @result      Error if the stream cannot be read or parsing fails,
+   *              success otherwise.
+   * @see         Append(const uint8_t*, size_t)
+   */
+  Error Append(std::istream& stream);
+
+  /*!
+   * @function    Finish
+   * @abstract    Notifies the parser that all the data was appended.
+   * @discussion  A box extending to the end of the data is completed.
+   *              Other incomplete boxes are errors.
+   * @result      Error if the last box is incomplete or cannot be
+   *              parsed, success otherwise.
+   */
+  Error Finish();
+
+  /*!
+   * @function    Reset
+   * @abstract    Discards the parsed boxes, to parse another file.
+   */
+  void Reset();
+
+  /*!
+   * @function    GetFile
+   * @abstract    Gets the boxes parsed so far.
+   * @result      The file object, or nullptr if no box was parsed yet.
+   */
+  std::shared_ptr<File> GetFile() const;
+
+  /*!
+   * @function    GetParser
+   * @abstract    Gets the parser used to read boxes.
+   * @result      The parser.
+   */
+  Parser& GetParser();
+
+  /*!
+   * @function    SetBoxHandler
+   * @abstract    Sets the function called with each decoded box.
+   * @discussion  The handler is called with top-level boxes, after they
+   *              are added to the file.
+   * @param       handler The handler, or nullptr.
+   */
+  void SetBoxHandler(const BoxHandler& handler);
+
+  /*!
+   * @function    GetBytesAppended
+   * @abstract    Gets the number of bytes appended so far.
+   * @result      The number of bytes.
+   */
+  uint64_t GetBytesAppended() const;
+
+  /*!
+   * @function    GetPendingBytes
+   * @abstract    Gets the number of bytes kept for an incomplete box.
+   * @result      The number of bytes.
+   */
+  uint64_t GetPendingBytes() const;
+
+  /*!
+   * @function    swap
+   * @abstract    Swap two objects.
+   * @param       o1  The first object to swap.
+   * @param       o2  The second object to swap.
+   */
+  ISOBMFF_EXPORT friend void swap(IncrementalParser& o1,
+                                  IncrementalParser& o2);
+
+ private:
+  class IMPL;
+
+  std::unique_ptr<IMPL> impl;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_INCREMENTAL_PARSER_HPP */
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ParseContext.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_PARSE_CONTEXT_HPP
+#define ISOBMFF_PARSE_CONTEXT_HPP
+
+#include <Arena.hpp>
+#include <Box.hpp>
+#include <Macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ISOBMFF {
+/*!
+ * @class       ParseContext
+ * @abstract    State of a parse, available to the boxes being read.
+ * @discussion  The context holds the stack of the boxes being read, so
+ *              a box can look at the boxes it is found in, info values
+ *              set by callers or boxes, and scratch memory. Each parse
+ *              has its own context, starting with the info values of
+ *              the parser, and destroyed when the parse ends. Copies
+ *              have the same stack and info values, and their own
+ *              scratch memory.
+ */
+class ISOBMFF_EXPORT ParseContext {
+ public:
+  ParseContext();
+  ParseContext(const ParseContext& o);
+  ParseContext(ParseContext&& o) noexcept;
+  virtual ~ParseContext();
+
+  ParseContext& operator=(ParseContext o);
+
+  /*!
+   * @function    PushBox
+   * @abstract    Notifies the context that a box is about to be read.
+   * @discussion  Used by containers while parsing. Each call must be
+   *              balanced by a call to PopBox.
+   * @param       box     The box.
+   */
+  void PushBox(const Box& box);
+
+  /*!
+   * @function    PopBox
+   * @abstract    Notifies the context that a box has been read.
+   * @see         PushBox
+   */
+  void PopBox();
+
+  /*!
+   * @function    GetDepth
+   * @abstract    Gets the number of boxes being read.
+   * @result      The number of boxes.
+   */
+  size_t GetDepth() const;
+
+  /*!
+   * @function    GetBox
+   * @abstract    Gets one of the boxes being read.
+   * @param       level   0 for the innermost box, 1 for the box it is
+   *                      found in, and so on.
+   * @result      The box, or nullptr if level is too high.
+   */
+  const Box* GetBox(size_t level = 0) const;
+
+  /*!
+   * @function    GetParent
+   * @abstract    Gets the box the innermost box is found in.
+   * @result      The box, or nullptr for top-level boxes.
+   */
+  const Box* GetParent() const;
+
+  /*!
+   * @function    FindBox
+   * @abstract    Gets the innermost box being read having a given type.
+   * @result      The box, or nullptr.
+   */
+  template <typename T>
+  const T* FindBox() const {
+    for (size_t i = 0; i < this->GetDepth(); i++) {
+      const T* box = dynamic_cast<const T*>(this->GetBox(i));
+
+      if (box != nullptr) {
+        return box;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /*!
+   * @function    ExposeBox
+   * @abstract    Marks the innermost box as one its children depend on.
+   * @discussion  Boxes found in an exposed box are read with the rest of
+   *              the file, even with the LazyDecoding option, as their
+   *              parents may be gone by the time they are loaded.
+   */
+  void ExposeBox();
+
+  /*!
+   * @function    HasExposedBoxes
+   * @abstract    Checks whether one of the boxes being read is exposed.
+   * @result      true if a box is exposed, otherwise false.
+   * @see         ExposeBox
+   */
+  bool HasExposedBoxes() const;
+
+  /*!
+   * @function    GetInfo
+   * @abstract    Gets an info value in the context.
+   * @param       key The info key.
+   * @result      The value for the info key, or nullptr.
+   * @see         SetInfo
+   */
+  const void* GetInfo(const std::string& key) const;
+
+  /*!
+   * @function    SetInfo
+   * @abstract    Sets an info value in the context.
+   * @discussion  This method can be used to store any kind of
+   *              contextual information that may be useful while
+   *              parsing. Info values are kept when the stack is
+   *              reset.
+   * @param       key     The info key.
+   * @param       value   The info value, or nullptr to remove it.
+   * @see         GetInfo
+   */
+  void SetInfo(const std::string& key, void* value);
+
+  /*!
+   * @function    HasInfo
+   * @abstract    Checks whether info values are set.
+   * @result      true if a value is set, otherwise false.
+   */
+  bool HasInfo() const;
+
+  /*!
+   * @function    GetScratch
+   * @abstract    Gets memory for temporary data.
+   * @discussion  The arena is created when first used, and is destroyed
+   *              with the context or when it is reset. It is not to be
+   *              used from several threads at once.
+   * @result      The arena.
+   */
+  Arena& GetScratch();
+
+  /*!
+   * @function    Reset
+   * @abstract    Clears the stack, and releases the scratch memory.
+   */
+  void Reset();
+
+  /*!
+   * @function    swap
+   * @abstract    Swap two objects.
+   * @param       o1  The first object to swap.
+   * @param       o2  The second object to swap.
+   */
+  ISOBMFF_EXPORT friend void swap(ParseContext& o1, ParseContext& o2);
+
+ private:
+  class IMPL;
+
+  std::unique_ptr<IMPL> impl;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_PARSE_CONTEXT_HPP */
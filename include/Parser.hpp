@@ -32,15 +32,22 @@
 #define ISOBMFF_PARSER_HPP
 
 #include <Box.hpp>
+#include <Container.hpp>
 #include <File.hpp>
 #include <Macros.hpp>
+#include <ParseContext.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ISOBMFF {
+class BoxVisitor;
+class ThreadPool;
+
 /*!
  * @class       Parser
  * @abstract    ISO media file parser.
@@ -62,8 +69,54 @@ class ISOBMFF_EXPORT Parser {
    * @enum        Options
    * @abstract    Parser options.
    * @constant    DoNotSkipMDATData Keep data found in MDAT boxes.
+   * @constant    DoNotMapFiles     Read files through a regular file
+   *                                stream instead of a memory mapping.
+   * @constant    LazyDecoding      Only read box headers while parsing,
+   *                                and read box data on first access.
+   * @constant    ArenaAllocation   Allocate the parsed boxes from a
+   *                                single memory region (see Arena),
+   *                                freed when the last box is released.
+   * @constant    ParallelDecoding  Read sibling boxes having children,
+   *                                such as the tracks of a movie or the
+   *                                fragments of a file, on a thread
+   *                                pool (see SetThreadPool).
+   * @discussion  With LazyDecoding, the parsed boxes keep a reference to
+   *              the parsed data. Files and data vectors are retained
+   *              by the boxes, but streams and borrowed data passed to
+   *              Parse must outlive the parsed boxes.
+   */
+  enum class Options : uint64_t {
+    DoNotSkipMDATData = 1 << 0,
+    DoNotMapFiles = 1 << 1,
+    LazyDecoding = 1 << 2,
+    ArenaAllocation = 1 << 3,
+    ParallelDecoding = 1 << 4
+  };
+
+  /*!
+   * @constant    DefaultMaxDepth
+   * @abstract    Default maximum nesting level of the boxes being read.
+   */
+  static constexpr size_t DefaultMaxDepth = 64;
+
+  /*!
+   * @struct      BoxMapEntry
+   * @abstract    Location of a box found by Scan.
+   * @field       path        The types of the box and of its parents,
+   *                          separated by slashes (e.g. "moov/trak").
+   * @field       type        The box type, as a FourCC.
+   * @field       offset      The offset of the box header in the file.
+   * @field       headerSize  The size of the box header.
+   * @field       size        The size of the box, header included.
+   * @see         Utils::FourCC
    */
-  enum class Options : uint64_t { DoNotSkipMDATData = 1 << 0 };
+  struct BoxMapEntry {
+    std::string path;
+    uint32_t type;
+    uint64_t offset;
+    uint64_t headerSize;
+    uint64_t size;
+  };
 
   /*!
    * @function    Parser
@@ -85,6 +138,14 @@ class ISOBMFF_EXPORT Parser {
    */
   Parser(const std::vector<uint8_t>& data);
 
+  /*!
+   * @function    Parser
+   * @abstract    Creates a parser for borrowed data.
+   * @param       data    The data bytes.
+   * @param       size    The number of bytes.
+   */
+  Parser(const uint8_t* data, size_t size);
+
   /*!
    * @function    Parser
    * @abstract    Creates a parser for a stream.
@@ -127,6 +188,9 @@ class ISOBMFF_EXPORT Parser {
    * @discussion  When encountering a box of the specified custom type,
    *              the parser will invoke the lambda to create a new
    *              object of the correct type.
+   *              Registered types take precedence over the built-in
+   *              ones, and a nullptr lambda makes the parser read the
+   *              type as a generic box.
    */
   Error RegisterBox(const std::string& type,
                     const std::function<std::shared_ptr<Box>()>& createBox);
@@ -138,6 +202,37 @@ class ISOBMFF_EXPORT Parser {
    */
   Error RegisterContainerBox(const std::string& type);
 
+  /*!
+   * @function    AllowBoxPath
+   * @abstract    Restricts parsing to the boxes of a path.
+   * @param       path    Box types separated by slashes, such as
+   *                      "meta/iloc". A "*" matches any type.
+   * @result      Error if the path is invalid, success otherwise.
+   * @discussion  Once paths are allowed, only the boxes they designate,
+   *              their children, and the boxes containing them are
+   *              parsed. Other boxes are skipped: they are kept in the
+   *              tree as generic boxes, without data.
+   * @see         DenyBoxPath
+   */
+  Error AllowBoxPath(const std::string& path);
+
+  /*!
+   * @function    DenyBoxPath
+   * @abstract    Skips the boxes of a path, and their children.
+   * @param       path    Box types separated by slashes, such as
+   *                      "moov/udta". A "*" matches any type.
+   * @result      Error if the path is invalid, success otherwise.
+   * @discussion  Denied paths take precedence over allowed ones.
+   * @see         AllowBoxPath
+   */
+  Error DenyBoxPath(const std::string& path);
+
+  /*!
+   * @function    ClearBoxPaths
+   * @abstract    Removes all allowed and denied box paths.
+   */
+  void ClearBoxPaths();
+
   /*!
    * @function    CreateBox
    * @abstract    Creates a new box for a specific type.
@@ -150,6 +245,9 @@ class ISOBMFF_EXPORT Parser {
    * @function    Parse
    * @abstract    Parses a file.
    * @discussion  This will discard any previously parsed file.
+   *              The file is memory-mapped when possible, unless the
+   *              DoNotMapFiles option is set. If mapping fails, the
+   *              file is read through a regular file stream.
    * @param       path    The file's path.
    * @result      Error if parsing fails, success otherwise.
    */
@@ -164,6 +262,17 @@ class ISOBMFF_EXPORT Parser {
    */
   Error Parse(const std::vector<uint8_t>& data);
 
+  /*!
+   * @function    Parse
+   * @abstract    Parses borrowed data.
+   * @discussion  This will discard any previously parsed file/data.
+   *              The bytes are read in place and are not copied.
+   * @param       data    The data bytes.
+   * @param       size    The number of bytes.
+   * @result      Error if parsing fails, success otherwise.
+   */
+  Error Parse(const uint8_t* data, size_t size);
+
   /*!
    * @function    Parse
    * @abstract    Parses data from a stream.
@@ -173,6 +282,98 @@ class ISOBMFF_EXPORT Parser {
    */
   Error Parse(BinaryStream& stream);
 
+  /*!
+   * @function    Parse
+   * @abstract    Parses a file, passing its boxes to a visitor.
+   * @discussion  Boxes are visited in file order, while they are read,
+   *              and no box tree is built: a box is released once
+   *              visited, unless the visitor keeps it. The visitor may
+   *              skip a box and its children, or stop parsing. Boxes
+   *              are descended into like with Scan, and box path
+   *              filters apply. The parsed file, if any, is kept.
+   * @param       path    The file's path.
+   * @param       visitor The visitor.
+   * @result      Error if parsing fails, success otherwise, including
+   *              when the visitor stops parsing.
+   * @see         BoxVisitor
+   */
+  Error Parse(const std::string& path, BoxVisitor& visitor);
+
+  /*!
+   * @function    Parse
+   * @abstract    Parses borrowed data, passing its boxes to a visitor.
+   * @param       data    The data bytes.
+   * @param       size    The number of bytes.
+   * @param       visitor The visitor.
+   * @result      Error if parsing fails, success otherwise.
+   * @see         Parse(const std::string&, BoxVisitor&)
+   */
+  Error Parse(const uint8_t* data, size_t size, BoxVisitor& visitor);
+
+  /*!
+   * @function    Parse
+   * @abstract    Parses a stream, passing its boxes to a visitor.
+   * @discussion  Parsing starts at the current stream position, which
+   *              is left unchanged.
+   * @param       stream  The stream object.
+   * @param       visitor The visitor.
+   * @result      Error if parsing fails, success otherwise.
+   * @see         Parse(const std::string&, BoxVisitor&)
+   */
+  Error Parse(BinaryStream& stream, BoxVisitor& visitor);
+
+  /*!
+   * @function    Scan
+   * @abstract    Lists the boxes of a file, without parsing them.
+   * @discussion  Only box headers are read. Container boxes, including
+   *              the ones registered with RegisterContainerBox, are
+   *              descended into, and so are meta and ipco boxes. Other
+   *              boxes are listed, but not their children. Boxes are
+   *              listed in file order, parents before their children.
+   *              A box with a size of 0 extends to the end of its
+   *              parent. The parsed file, if any, is kept.
+   * @param       path    The file's path.
+   * @param       boxes   On return, the boxes found, including the ones
+   *                      found before an error.
+   * @result      Error if scanning fails, success otherwise.
+   */
+  Error Scan(const std::string& path, std::vector<BoxMapEntry>& boxes) const;
+
+  /*!
+   * @function    Scan
+   * @abstract    Lists the boxes in borrowed data, without parsing them.
+   * @param       data    The data bytes.
+   * @param       size    The number of bytes.
+   * @param       boxes   On return, the boxes found.
+   * @result      Error if scanning fails, success otherwise.
+   * @see         Scan(const std::string&, std::vector<BoxMapEntry>&)
+   */
+  Error Scan(const uint8_t* data, size_t size,
+             std::vector<BoxMapEntry>& boxes) const;
+
+  /*!
+   * @function    Scan
+   * @abstract    Lists the boxes in a stream, without parsing them.
+   * @discussion  Scanning starts at the current stream position, which
+   *              is left unchanged.
+   * @param       stream  The stream object.
+   * @param       boxes   On return, the boxes found.
+   * @result      Error if scanning fails, success otherwise.
+   * @see         Scan(const std::string&, std::vector<BoxMapEntry>&)
+   */
+  Error Scan(BinaryStream& stream, std::vector<BoxMapEntry>& boxes) const;
+
+  /*!
+   * @function    CheckFileHeader
+   * @abstract    Checks that a stream starts like an ISO media file.
+   * @discussion  The type of the first box is read in place, so the
+   *              stream position is left unchanged.
+   * @param       stream  The stream object.
+   * @result      Error if the stream cannot be read, or if the first
+   *              box cannot start a file, success otherwise.
+   */
+  static Error CheckFileHeader(BinaryStream& stream);
+
   /*!
    * @function    GetFile
    * @abstract    Upon successful parsing, gets the file object.
@@ -237,12 +438,58 @@ class ISOBMFF_EXPORT Parser {
    */
   bool HasOption(Options option);
 
+  /*!
+   * @function    GetThreadPool
+   * @abstract    Gets the pool used with the ParallelDecoding option.
+   * @result      The pool, or nullptr for the default pool.
+   * @see         ThreadPool::GetDefault
+   */
+  std::shared_ptr<ThreadPool> GetThreadPool() const;
+
+  /*!
+   * @function    SetThreadPool
+   * @abstract    Sets the pool used with the ParallelDecoding option.
+   * @discussion  Boxes are read in order when the pool has a single
+   *              thread, as the default pool does on single-core hosts.
+   * @param       pool    The pool, or nullptr for the default pool.
+   */
+  void SetThreadPool(const std::shared_ptr<ThreadPool>& pool);
+
+  /*!
+   * @function    GetMaxDepth
+   * @abstract    Gets the maximum nesting level of the boxes being read.
+   * @result      The maximum level.
+   * @see         DefaultMaxDepth
+   */
+  size_t GetMaxDepth() const;
+
+  /*!
+   * @function    SetMaxDepth
+   * @abstract    Sets the maximum nesting level of the boxes being read.
+   * @discussion  Parsing fails with boxes nested deeper than that, so
+   *              crafted files cannot exhaust the call stack.
+   * @param       value   The maximum level.
+   */
+  void SetMaxDepth(size_t value);
+
+  /*!
+   * @function    GetContext
+   * @abstract    Gets the context of the current parse.
+   * @discussion  Boxes use it while reading their data, to access the
+   *              boxes they are found in. Outside of a parse, this is
+   *              the context each parse starts from, holding the info
+   *              values of the parser.
+   * @result      The context.
+   * @see         ParseContext
+   */
+  ParseContext& GetContext();
+
   /*!
    * @function    GetInfo
    * @abstract    Gets an info value in the parser.
    * @param       key The info key.
    * @result      The value for the info key, or nullptr.
-   * @see         SetInfo
+   * @see         ParseContext::GetInfo
    */
   const void* GetInfo(const std::string& key);
 
@@ -254,10 +501,106 @@ class ISOBMFF_EXPORT Parser {
    *              parsing.
    * @param       key     The info key.
    * @param       value   The info value.
-   * @see         GetInfo
+   * @see         ParseContext::SetInfo
    */
   void SetInfo(const std::string& key, void* value);
 
+  /*!
+   * @function    IsBoxSelected
+   * @abstract    Checks whether a box passes the box path filters.
+   * @discussion  Used by containers while parsing.
+   * @param       type    The type of a box found in the box being read.
+   * @result      true if the box must be read, false if it is skipped.
+   * @see         AllowBoxPath
+   * @see         DenyBoxPath
+   */
+  bool IsBoxSelected(const std::string& type) const;
+
+  /*!
+   * @function    EnterBox
+   * @abstract    Notifies the parser that a box is about to be read.
+   * @discussion  Used by containers while parsing, so the parser knows
+   *              the path of the boxes being read. Each call must be
+   *              balanced by a call to LeaveBox.
+   * @param       type    The type of the box.
+   */
+  void EnterBox(const std::string& type);
+
+  /*!
+   * @function    LeaveBox
+   * @abstract    Notifies the parser that a box has been read.
+   * @see         EnterBox
+   */
+  void LeaveBox();
+
+  /*!
+   * @function    DeferBox
+   * @abstract    Defers reading a box's data, if the LazyDecoding option
+   *              is set.
+   * @discussion  Used by containers while parsing. Container boxes are
+   *              never deferred, so the box tree is always complete.
+   *              Boxes are not deferred either when they are read from
+   *              a stream other than the one being parsed, while an
+   *              exposed box is read (see ParseContext::ExposeBox), or
+   *              while contextual information is set (see SetInfo).
+   * @param       box     The box whose data starts at the current
+   *                      stream position.
+   * @param       stream  The stream being read.
+   * @param       length  The length of the box data.
+   * @result      true if the box was deferred, false if its data must
+   *              be read now.
+   * @see         Box::Load
+   */
+  bool DeferBox(const std::shared_ptr<Box>& box, BinaryStream& stream,
+                size_t length);
+
+  /*!
+   * @function    ReadChildren
+   * @abstract    Reads the boxes found in a box's data.
+   * @discussion  Used by boxes having children, once they have read
+   *              their own fields. Boxes are read up to the end of the
+   *              stream, and added to the container in order. Nested
+   *              containers are read in the same loop, using a stack
+   *              of their data windows rather than the call stack.
+   * @param       container   The box the boxes are found in.
+   * @param       stream      The stream, at the first box.
+   * @result      Error if reading fails, or if boxes are nested deeper
+   *              than the maximum depth, success otherwise.
+   * @see         SetMaxDepth
+   */
+  Error ReadChildren(Container& container, BinaryStream& stream);
+
+  /*!
+   * @function    ReadBoxData
+   * @abstract    Reads a box's data from a copy of it.
+   * @discussion  The box location must be set. The offsets of the
+   *              boxes found in the data are relative to the file, as
+   *              if the data was read from it.
+   * @param       box     The box.
+   * @param       data    The box data, without the box header.
+   * @param       size    The number of bytes.
+   * @result      Error if reading fails, success otherwise.
+   */
+  Error ReadBoxData(const std::shared_ptr<Box>& box, const uint8_t* data,
+                    size_t size);
+
+  /*!
+   * @function    ReadBoxes
+   * @abstract    Reads the data of sibling boxes having children.
+   * @discussion  Used by containers while parsing, once all their boxes
+   *              are known. With the ParallelDecoding option, the boxes
+   *              are read concurrently, each with a copy of this parser
+   *              and of its data. Otherwise, or if there is only one box,
+   *              they are read in order. Box locations must be set.
+   * @param       boxes   The boxes.
+   * @param       stream  The stream the boxes are found in.
+   * @result      Error if reading a box fails (the first one, in the
+   *              order of the boxes), or if the boxes are nested too
+   *              deeply, success otherwise.
+   */
+  Error ReadBoxes(const std::vector<std::shared_ptr<Box> >& boxes,
+                  BinaryStream& stream);
+
   /*!
    * @function    swap
    * @abstract    Swap two objects.
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ParserPool.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_PARSER_POOL_HPP
+#define ISOBMFF_PARSER_POOL_HPP
+
+#include <Error.hpp>
+#include <File.hpp>
+#include <Macros.hpp>
+#include <Parser.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ISOBMFF {
+/*!
+ * @class       ParserPool
+ * @abstract    Parses batches of files concurrently.
+ * @discussion  Each worker has its own copy of a parser, reused from
+ *              file to file, and parses one file at a time, so at most
+ *              one parsed file per worker is in memory, unless the
+ *              callback keeps it. Files are shared among the workers
+ *              up front, and idle workers take files from the busiest
+ *              ones. A pool parses one batch at a time.
+ */
+class ISOBMFF_EXPORT ParserPool {
+ public:
+  /*!
+   * @typedef     Callback
+   * @abstract    Called on a worker thread, once a file is parsed.
+   * @discussion  The parameters are the index of the file in the batch,
+   *              the parsing error, if any, and the parsed file.
+   */
+  typedef std::function<void(size_t, const Error&,
+                             const std::shared_ptr<File>&)>
+      Callback;
+
+  /*!
+   * @typedef     Buffer
+   * @abstract    Borrowed data bytes, and their number.
+   */
+  typedef std::pair<const uint8_t*, size_t> Buffer;
+
+  /*!
+   * @function    ParserPool
+   * @abstract    Creates a pool.
+   * @param       parser  The parser copied by each worker, with its
+   *                      options, box registrations and filters.
+   * @param       threads The number of workers. With 0, there is one
+   *                      per hardware thread.
+   */
+  explicit ParserPool(const Parser& parser = Parser(), size_t threads = 0);
+
+  ParserPool(const ParserPool& o) = delete;
+  ParserPool& operator=(const ParserPool& o) = delete;
+
+  /*!
+   * @function    ~ParserPool
+   * @abstract    Destructor.
+   */
+  virtual ~ParserPool();
+
+  /*!
+   * @function    GetWorkerCount
+   * @abstract    Gets the number of workers.
+   * @result      The number of workers.
+   */
+  size_t GetWorkerCount() const;
+
+  /*!
+   * @function    Parse
+   * @abstract    Parses files, and waits for all of them.
+   * @param       paths       The files' paths.
+   * @param       callback    Called with each parsed file.
+   */
+  void Parse(const std::vector<std::string>& paths, const Callback& callback);
+
+  /*!
+   * @function    Parse
+   * @abstract    Parses borrowed data, and waits for all of it.
+   * @param       buffers     The data of each file, which must outlive
+   *                          the parsed files with the LazyDecoding
+   *                          option.
+   * @param       callback    Called with each parsed file.
+   */
+  void Parse(const std::vector<Buffer>& buffers, const Callback& callback);
+
+ private:
+  class IMPL;
+
+  std::unique_ptr<IMPL> impl;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_PARSER_POOL_HPP */
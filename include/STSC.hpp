@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      STSC.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_STSC_HPP
+#define ISOBMFF_STSC_HPP
+
+#include <ChunkOffsets.hpp>
+#include <FullBox.hpp>
+#include <Macros.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace ISOBMFF {
+class ISOBMFF_EXPORT STSC : public FullBox {
+ public:
+  // a chunk, and the samples it holds; samples are numbered from 0
+  struct Chunk {
+    uint64_t offset;
+    uint32_t firstSample;
+    uint32_t sampleCount;
+    uint32_t sampleDescriptionIndex;
+  };
+
+  STSC();
+  STSC(const STSC& o);
+  STSC(STSC&& o) noexcept;
+  virtual ~STSC() override;
+
+  STSC& operator=(STSC o);
+
+  Error ReadData(Parser& parser, BinaryStream& stream) override;
+  std::vector<std::pair<std::string, std::string> > GetDisplayableProperties()
+      const override;
+
+  size_t GetEntryCount() const;
+  uint32_t GetFirstChunk(size_t index) const;
+  uint32_t GetSamplesPerChunk(size_t index) const;
+  uint32_t GetSampleDescriptionIndex(size_t index) const;
+
+  // expands the entries to one chunk per chunk offset
+  Error GetChunks(const ChunkOffsets& offsets,
+                  std::vector<Chunk>& chunks) const;
+
+  ISOBMFF_EXPORT friend void swap(STSC& o1, STSC& o2);
+
+ private:
+  class IMPL;
+
+  std::unique_ptr<IMPL> impl;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_STSC_HPP */
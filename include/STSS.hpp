@@ -54,6 +54,14 @@ class ISOBMFF_EXPORT STSS : public FullBox {
   size_t GetEntryCount() const;
   uint32_t GetSampleNumber(size_t index) const;
 
+  // samples are numbered from 0, while entries number them from 1; the
+  // first of these calls indexes the entries, and sync samples are then
+  // checked in O(1), using a bitset when entries are dense enough, and
+  // found in O(log(entries))
+  bool IsSyncSample(uint64_t sample) const;
+  bool GetPreviousSyncSample(uint64_t sample, uint64_t& sync) const;
+  bool GetNextSyncSample(uint64_t sample, uint64_t& sync) const;
+
   ISOBMFF_EXPORT friend void swap(STSS& o1, STSS& o2);
 
  private:
@@ -55,6 +55,14 @@ class ISOBMFF_EXPORT STTS : public FullBox {
   uint32_t GetSampleCount(size_t index) const;
   uint32_t GetSampleOffset(size_t index) const;
 
+  // samples are numbered from 0, and times are in the media timescale;
+  // the first of these calls indexes the entries, in O(entries), and the
+  // following ones take O(log(entries))
+  uint64_t GetTotalSampleCount() const;
+  uint64_t GetDuration() const;
+  uint64_t GetDecodingTime(uint64_t sample) const;
+  uint64_t GetSampleAtTime(uint64_t time) const;
+
   ISOBMFF_EXPORT friend void swap(STTS& o1, STTS& o2);
 
  private:
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SampleTable.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SAMPLE_TABLE_HPP
+#define ISOBMFF_SAMPLE_TABLE_HPP
+
+#include <Container.hpp>
+#include <Error.hpp>
+#include <Macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ISOBMFF {
+/*!
+ * @class       SampleTable
+ * @abstract    Location, size and timing of the samples of a track.
+ * @discussion  The run-length tables of a track's stbl box (stsz or
+ *              stz2, stts, ctts, stsc, and stco or co64) are expanded
+ *              once, into one array per property, so each sample is
+ *              looked up in constant time. Sync samples are looked up
+ *              in the stss box, if any. Samples are numbered from 0,
+ *              and times are in the media timescale.
+ */
+class ISOBMFF_EXPORT SampleTable {
+ public:
+  /*!
+   * @constant    DefaultMaxSampleCount
+   * @abstract    Default number of samples above which tracks are refused.
+   */
+  static constexpr size_t DefaultMaxSampleCount = 1 << 22;
+
+  SampleTable();
+  SampleTable(const SampleTable& o);
+  SampleTable(SampleTable&& o) noexcept;
+  virtual ~SampleTable();
+
+  SampleTable& operator=(SampleTable o);
+
+  /*!
+   * @function    GetMaxSampleCount
+   * @abstract    Gets the number of samples above which tracks are refused.
+   * @result      The maximum number of samples.
+   * @see         DefaultMaxSampleCount
+   */
+  size_t GetMaxSampleCount() const;
+
+  /*!
+   * @function    SetMaxSampleCount
+   * @abstract    Sets the number of samples above which tracks are refused.
+   * @discussion  Each sample takes about 28 bytes.
+   * @param       value   The maximum number of samples.
+   */
+  void SetMaxSampleCount(size_t value);
+
+  /*!
+   * @function    Read
+   * @abstract    Builds the table of a track.
+   * @discussion  The tables are checked against each other, and against
+   *              the file size, before anything is allocated, so crafted
+   *              counts cannot exhaust memory.
+   * @param       trak        The trak box.
+   * @param       fileSize    The size of the file the samples are in.
+   * @result      Error if the track has no sample tables, if they are
+   *              inconsistent, if they have too many samples, or if
+   *              samples are past the end of the file, success
+   *              otherwise. On error, the table is left unchanged.
+   */
+  Error Read(const Container& trak, uint64_t fileSize);
+
+  /*!
+   * @function    GetSampleCount
+   * @abstract    Gets the number of samples.
+   * @result      The number of samples.
+   */
+  size_t GetSampleCount() const;
+
+  /*!
+   * @function    GetSampleOffset
+   * @abstract    Gets the offset of a sample's data in the file.
+   * @param       index   The sample number.
+   * @result      The offset.
+   */
+  uint64_t GetSampleOffset(size_t index) const;
+
+  /*!
+   * @function    GetSampleSize
+   * @abstract    Gets the size of a sample's data.
+   * @param       index   The sample number.
+   * @result      The size, in bytes.
+   */
+  uint32_t GetSampleSize(size_t index) const;
+
+  /*!
+   * @function    GetDecodingTime
+   * @abstract    Gets the decoding time of a sample.
+   * @param       index   The sample number.
+   * @result      The decoding time.
+   */
+  uint64_t GetDecodingTime(size_t index) const;
+
+  /*!
+   * @function    GetCompositionTime
+   * @abstract    Gets the composition time of a sample.
+   * @param       index   The sample number.
+   * @result      The composition time, which is the decoding time
+   *              without a ctts box.
+   */
+  int64_t GetCompositionTime(size_t index) const;
+
+  /*!
+   * @function    IsSyncSample
+   * @abstract    Checks whether a sample is a sync sample.
+   * @param       index   The sample number.
+   * @result      true for sync samples, and for all samples without a
+   *              stss box, otherwise false.
+   */
+  bool IsSyncSample(size_t index) const;
+
+  /*!
+   * @function    GetPreviousSyncSample
+   * @abstract    Finds the last sync sample at or before a sample.
+   * @param       index   The sample number.
+   * @param       sync    Set to the sync sample number, if found.
+   * @result      true if a sync sample is found, otherwise false.
+   */
+  bool GetPreviousSyncSample(size_t index, size_t& sync) const;
+
+  /*!
+   * @function    GetNextSyncSample
+   * @abstract    Finds the first sync sample at or after a sample.
+   * @param       index   The sample number.
+   * @param       sync    Set to the sync sample number, if found.
+   * @result      true if a sync sample is found, otherwise false.
+   */
+  bool GetNextSyncSample(size_t index, size_t& sync) const;
+
+  ISOBMFF_EXPORT friend void swap(SampleTable& o1, SampleTable& o2);
+
+ private:
+  class IMPL;
+
+  std::unique_ptr<IMPL> impl;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_SAMPLE_TABLE_HPP */
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ThreadPool.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_THREAD_POOL_HPP
+#define ISOBMFF_THREAD_POOL_HPP
+
+#include <Macros.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ISOBMFF {
+/*!
+ * @class       ThreadPool
+ * @abstract    Fixed set of threads running tasks.
+ * @discussion  Used by the ParallelDecoding parser option. Threads are
+ *              started when the pool is created, and are joined when
+ *              it is destroyed.
+ */
+class ISOBMFF_EXPORT ThreadPool {
+ public:
+  typedef std::function<void()> Task;
+
+  /*!
+   * @function    ThreadPool
+   * @abstract    Creates a pool.
+   * @param       threads The number of threads. With 0, there is one
+   *                      per hardware thread.
+   */
+  explicit ThreadPool(size_t threads = 0);
+
+  ThreadPool(const ThreadPool& o) = delete;
+  ThreadPool& operator=(const ThreadPool& o) = delete;
+
+  /*!
+   * @function    ~ThreadPool
+   * @abstract    Waits for the submitted tasks, and stops the threads.
+   */
+  virtual ~ThreadPool();
+
+  /*!
+   * @function    GetDefault
+   * @abstract    Gets the pool shared by parsers.
+   * @result      The pool, with one thread per hardware thread.
+   */
+  static ThreadPool& GetDefault();
+
+  /*!
+   * @function    GetThreadCount
+   * @abstract    Gets the number of threads.
+   * @result      The number of threads.
+   */
+  size_t GetThreadCount() const;
+
+  /*!
+   * @function    Submit
+   * @abstract    Runs a task on one of the threads.
+   * @param       task    The task.
+   */
+  void Submit(const Task& task);
+
+  /*!
+   * @function    Run
+   * @abstract    Runs tasks, and waits for all of them.
+   * @discussion  The calling thread runs tasks too, so a task may call
+   *              Run itself without waiting for a free thread.
+   * @param       tasks   The tasks.
+   */
+  void Run(const std::vector<Task>& tasks);
+
+ private:
+  class IMPL;
+
+  std::unique_ptr<IMPL> impl;
+};
+}  // namespace ISOBMFF
+
+#endif /* ISOBMFF_THREAD_POOL_HPP */
@@ -103,6 +103,23 @@ ISOBMFF_EXPORT std::string ToHexString(uint32_t u);
  */
 ISOBMFF_EXPORT std::string ToHexString(uint64_t u);
 
+/*!
+ * @function    FourCC
+ * @abstract    Packs a four character code into a 32-bits unsigned integer.
+ * @param       s   The four character code.
+ * @result      The packed code, first character in the most significant
+ *              byte, or 0 if the string is not 4 characters long.
+ */
+ISOBMFF_EXPORT uint32_t FourCC(const std::string& s);
+
+/*!
+ * @function    FourCCToString
+ * @abstract    Unpacks a four character code packed by `FourCC`.
+ * @param       fourcc  The packed code.
+ * @result      The four character code.
+ */
+ISOBMFF_EXPORT std::string FourCCToString(uint32_t fourcc);
+
 /*!
  * @function        ToString
  * @abstract        Returns a string representation of a vector of values.
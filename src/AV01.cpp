@@ -29,10 +29,11 @@
  */
 
 #include <AV01.hpp>
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
+#include <Parser.hpp>
 
 namespace ISOBMFF {
-class AV01::IMPL {
+class AV01::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -76,7 +77,6 @@ void swap(AV01& o1, AV01& o2) {
 }
 
 Error AV01::ReadData(Parser& parser, BinaryStream& stream) {
-  ContainerBox container("????");
   Error err;
 
   uint8_t temp8;
@@ -146,10 +146,10 @@ Error AV01::ReadData(Parser& parser, BinaryStream& stream) {
   err = stream.ReadBigEndianUInt16(temp16);
   if (err) return err;
 
-  err = container.ReadData(parser, stream);
-  if (err) return err;
+  this->impl->_boxes.clear();
 
-  this->impl->_boxes = container.GetBoxes();
+  err = parser.ReadChildren(*(this), stream);
+  if (err) return err;
 
   return Error();
 }
@@ -29,10 +29,11 @@
  */
 
 #include <AVC1.hpp>
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
+#include <Parser.hpp>
 
 namespace ISOBMFF {
-class AVC1::IMPL {
+class AVC1::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -76,7 +77,6 @@ void swap(AVC1& o1, AVC1& o2) {
 }
 
 Error AVC1::ReadData(Parser& parser, BinaryStream& stream) {
-  ContainerBox container("????");
   Error err;
 
   uint8_t temp8;
@@ -146,10 +146,10 @@ Error AVC1::ReadData(Parser& parser, BinaryStream& stream) {
   err = stream.ReadBigEndianUInt16(temp16);
   if (err) return err;
 
-  err = container.ReadData(parser, stream);
-  if (err) return err;
+  this->impl->_boxes.clear();
 
-  this->impl->_boxes = container.GetBoxes();
+  err = parser.ReadChildren(*(this), stream);
+  if (err) return err;
 
   return Error();
 }
@@ -29,11 +29,12 @@
  */
 
 #include <AVCC.hpp>
+#include <Arena.hpp>
 #include <Parser.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class AVCC::IMPL {
+class AVCC::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
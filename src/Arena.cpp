@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Arena.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <Arena.hpp>
+#include <atomic>
+#include <new>
+#include <vector>
+
+namespace ISOBMFF {
+class Arena::IMPL {
+ public:
+  IMPL(size_t chunkSize);
+  ~IMPL();
+
+  uint8_t* ReserveChunk();
+  uint8_t* ReserveLargeChunk(size_t size);
+
+  size_t _chunkSize;
+  std::vector<std::unique_ptr<uint8_t[]> > _chunks;
+  std::vector<std::unique_ptr<uint8_t[]> > _largeChunks;
+  uint8_t* _current;
+  uint8_t* _end;
+  size_t _allocated;
+  size_t _reserved;
+  std::atomic<size_t> _references;
+};
+
+constexpr size_t Arena::DefaultChunkSize;
+
+static thread_local Arena* CurrentArena = nullptr;
+
+/*
+ * Default-sized chunks of destroyed arenas are kept for the next arenas
+ * of the same thread. Requesting such large blocks from malloc makes it
+ * consolidate its free lists, which can cost more than parsing a small
+ * file.
+ */
+static constexpr size_t MaxCachedChunks = 4;
+static thread_local bool ChunkCacheDestroyed = false;
+
+class ChunkCache {
+ public:
+  ~ChunkCache() { ChunkCacheDestroyed = true; }
+
+  std::vector<std::unique_ptr<uint8_t[]> > _chunks;
+};
+
+static std::vector<std::unique_ptr<uint8_t[]> >* GetChunkCache() {
+  static thread_local ChunkCache cache;
+
+  // arenas may outlive the cache, when released while the thread exits
+  return (ChunkCacheDestroyed) ? nullptr : &(cache._chunks);
+}
+
+/*
+ * Object allocations are prefixed with the arena they come from (or
+ * nullptr for heap allocations), so deletion knows what to do.
+ */
+static constexpr size_t ObjectHeaderSize = alignof(std::max_align_t);
+
+Arena::Arena(size_t chunkSize) : impl(std::make_unique<IMPL>(chunkSize)) {}
+
+Arena::~Arena() {}
+
+std::shared_ptr<Arena> Arena::Create(size_t chunkSize) {
+  return std::shared_ptr<Arena>(new Arena(chunkSize),
+                                [](Arena* arena) { arena->Release(); });
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  uintptr_t current = reinterpret_cast<uintptr_t>(this->impl->_current);
+  uintptr_t aligned = (current + alignment - 1) & ~(alignment - 1);
+
+  if (this->impl->_current == nullptr ||
+      size > static_cast<size_t>(
+                 this->impl->_end - reinterpret_cast<uint8_t*>(aligned)) ||
+      aligned < current) {
+    // large allocations get their own chunk, so the current one is kept
+    if (size + alignment > this->impl->_chunkSize / 4) {
+      uint8_t* chunk = this->impl->ReserveLargeChunk(size + alignment);
+      uintptr_t start = reinterpret_cast<uintptr_t>(chunk);
+
+      this->impl->_allocated += size + alignment;
+
+      return reinterpret_cast<void*>((start + alignment - 1) &
+                                     ~(alignment - 1));
+    }
+
+    this->impl->_current = this->impl->ReserveChunk();
+    this->impl->_end = this->impl->_current + this->impl->_chunkSize;
+
+    current = reinterpret_cast<uintptr_t>(this->impl->_current);
+    aligned = (current + alignment - 1) & ~(alignment - 1);
+  }
+
+  uint8_t* p = reinterpret_cast<uint8_t*>(aligned);
+
+  this->impl->_allocated +=
+      static_cast<size_t>(p - this->impl->_current) + size;
+  this->impl->_current = p + size;
+
+  return p;
+}
+
+size_t Arena::GetAllocatedSize() const { return this->impl->_allocated; }
+
+size_t Arena::GetReservedSize() const { return this->impl->_reserved; }
+
+Arena* Arena::GetCurrent() { return CurrentArena; }
+
+void Arena::Retain() {
+  this->impl->_references.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ * Only shared arenas drop to zero references, as the initial one is
+ * released by the deleter set in Create.
+ */
+void Arena::Release() {
+  if (this->impl->_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+Arena::Scope::Scope(Arena* arena) : _previous(CurrentArena) {
+  CurrentArena = arena;
+}
+
+Arena::Scope::~Scope() { CurrentArena = this->_previous; }
+
+void* Arena::Object::operator new(std::size_t size) {
+  Arena* arena = CurrentArena;
+  void* p;
+
+  if (arena != nullptr) {
+    p = arena->Allocate(ObjectHeaderSize + size, alignof(std::max_align_t));
+    arena->Retain();
+  } else {
+    p = ::operator new(ObjectHeaderSize + size);
+  }
+
+  *(static_cast<Arena**>(p)) = arena;
+
+  return static_cast<uint8_t*>(p) + ObjectHeaderSize;
+}
+
+void Arena::Object::operator delete(void* p) noexcept {
+  if (p == nullptr) {
+    return;
+  }
+
+  void* header = static_cast<uint8_t*>(p) - ObjectHeaderSize;
+  Arena* arena = *(static_cast<Arena**>(header));
+
+  // arena memory is only released with the arena itself
+  if (arena == nullptr) {
+    ::operator delete(header);
+  } else {
+    arena->Release();
+  }
+}
+
+Arena::IMPL::IMPL(size_t chunkSize)
+    : _chunkSize((chunkSize > 0) ? chunkSize : DefaultChunkSize),
+      _current(nullptr),
+      _end(nullptr),
+      _allocated(0),
+      _reserved(0),
+      _references(1) {}
+
+Arena::IMPL::~IMPL() {
+  std::vector<std::unique_ptr<uint8_t[]> >* cache =
+      (this->_chunkSize == DefaultChunkSize) ? GetChunkCache() : nullptr;
+
+  if (cache == nullptr) {
+    return;
+  }
+
+  for (auto& chunk : this->_chunks) {
+    if (cache->size() >= MaxCachedChunks) {
+      break;
+    }
+
+    cache->push_back(std::move(chunk));
+  }
+}
+
+uint8_t* Arena::IMPL::ReserveChunk() {
+  std::vector<std::unique_ptr<uint8_t[]> >* cache =
+      (this->_chunkSize == DefaultChunkSize) ? GetChunkCache() : nullptr;
+
+  if (cache != nullptr && cache->empty() == false) {
+    this->_chunks.push_back(std::move(cache->back()));
+    cache->pop_back();
+  } else {
+    this->_chunks.push_back(
+        std::unique_ptr<uint8_t[]>(new uint8_t[this->_chunkSize]));
+  }
+
+  this->_reserved += this->_chunkSize;
+
+  return this->_chunks.back().get();
+}
+
+uint8_t* Arena::IMPL::ReserveLargeChunk(size_t size) {
+  this->_largeChunks.push_back(std::unique_ptr<uint8_t[]>(new uint8_t[size]));
+  this->_reserved += size;
+
+  return this->_largeChunks.back().get();
+}
+}  // namespace ISOBMFF
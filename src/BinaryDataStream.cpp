@@ -41,10 +41,14 @@ class BinaryDataStream::IMPL {
  public:
   IMPL();
   IMPL(const std::vector<uint8_t>& data);
+  IMPL(const uint8_t* data, size_t size);
   IMPL(const IMPL& o);
   ~IMPL();
 
   std::vector<uint8_t> _data;
+  bool _owned;
+  const uint8_t* _bytes;
+  size_t _size;
   size_t _pos;
 };
 
@@ -53,6 +57,9 @@ BinaryDataStream::BinaryDataStream() : impl(std::make_unique<IMPL>()) {}
 BinaryDataStream::BinaryDataStream(const std::vector<uint8_t>& data)
     : impl(std::make_unique<IMPL>(data)) {}
 
+BinaryDataStream::BinaryDataStream(const uint8_t* data, size_t size)
+    : impl(std::make_unique<IMPL>(data, size)) {}
+
 BinaryDataStream::BinaryDataStream(const BinaryDataStream& o)
     : impl(std::make_unique<IMPL>(*(o.impl))) {}
 
@@ -68,18 +75,40 @@ BinaryDataStream& BinaryDataStream::operator=(BinaryDataStream o) {
 }
 
 Error BinaryDataStream::Read(uint8_t* buf, size_t size) {
-  if (size > this->impl->_data.size() - this->impl->_pos) {
+  if (size > this->impl->_size - this->impl->_pos) {
     return Error(ErrorCode::InsufficientData,
                  "Invalid read - Not enough data available");
   }
 
-  memcpy(buf, &(this->impl->_data[0]) + this->impl->_pos, size);
+  if (size > 0) {
+    memcpy(buf, this->impl->_bytes + this->impl->_pos, size);
+  }
 
   this->impl->_pos += size;
 
   return Error();
 }
 
+Error BinaryDataStream::ReadAt(uint64_t offset, uint8_t* buf,
+                               size_t size) const {
+  if (offset > this->impl->_size || size > this->impl->_size - offset) {
+    return Error(ErrorCode::InsufficientData,
+                 "Invalid read - Not enough data available");
+  }
+
+  if (size > 0) {
+    memcpy(buf, this->impl->_bytes + offset, size);
+  }
+
+  return Error();
+}
+
+bool BinaryDataStream::IsReadAtThreadSafe() const { return true; }
+
+const uint8_t* BinaryDataStream::GetBytes() const {
+  return this->impl->_bytes;
+}
+
 Error BinaryDataStream::Seek(std::streamoff offset, SeekDirection dir) {
   size_t pos;
 
@@ -101,7 +130,7 @@ Error BinaryDataStream::Seek(std::streamoff offset, SeekDirection dir) {
     err = numeric_cast<size_t>(abs_offset, std::abs(offset));
     if (err) return err;
 
-    pos = this->impl->_data.size() - abs_offset;
+    pos = this->impl->_size - abs_offset;
   } else if (offset < 0) {
     Error err;
     size_t abs_offset;
@@ -118,7 +147,7 @@ Error BinaryDataStream::Seek(std::streamoff offset, SeekDirection dir) {
     pos = this->impl->_pos + offset_val;
   }
 
-  if (pos > this->impl->_data.size()) {
+  if (pos > this->impl->_size) {
     return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
   }
 
@@ -129,18 +158,33 @@ Error BinaryDataStream::Seek(std::streamoff offset, SeekDirection dir) {
 
 size_t BinaryDataStream::Tell() const { return this->impl->_pos; }
 
+size_t BinaryDataStream::Size() const { return this->impl->_size; }
+
 void swap(BinaryDataStream& o1, BinaryDataStream& o2) {
   using std::swap;
 
   swap(o1.impl, o2.impl);
 }
 
-BinaryDataStream::IMPL::IMPL() : _pos(0) {}
+BinaryDataStream::IMPL::IMPL()
+    : _owned(true), _bytes(nullptr), _size(0), _pos(0) {}
 
 BinaryDataStream::IMPL::IMPL(const std::vector<uint8_t>& data)
-    : _data(data), _pos(0) {}
-
-BinaryDataStream::IMPL::IMPL(const IMPL& o) : _data(o._data), _pos(o._pos) {}
+    : _data(data),
+      _owned(true),
+      _bytes(_data.data()),
+      _size(_data.size()),
+      _pos(0) {}
+
+BinaryDataStream::IMPL::IMPL(const uint8_t* data, size_t size)
+    : _owned(false), _bytes(data), _size(size), _pos(0) {}
+
+BinaryDataStream::IMPL::IMPL(const IMPL& o)
+    : _data(o._data),
+      _owned(o._owned),
+      _bytes(o._owned ? _data.data() : o._bytes),
+      _size(o._size),
+      _pos(o._pos) {}
 
 BinaryDataStream::IMPL::~IMPL() {}
 }  // namespace ISOBMFF
\ No newline at end of file
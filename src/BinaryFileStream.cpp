@@ -28,35 +28,56 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <string.h>
+
 #include <BinaryFileStream.hpp>
 #include <Casts.hpp>
+#include <atomic>
+#include <cerrno>
 #include <cmath>
-#include <fstream>
 #include <vector>
 
 #ifdef _WIN32
 #include <WIN32.hpp>
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 namespace ISOBMFF {
 class BinaryFileStream::IMPL {
  public:
-  IMPL(const std::string& path);
+  IMPL(const std::string& path, size_t bufferSize);
   ~IMPL();
 
-  std::ifstream _stream;
+  bool IsOpen() const;
+  Error ReadFile(uint64_t offset, uint8_t* buf, size_t size) const;
+
   std::string _path;
   size_t _size;
   size_t _pos;
+  std::vector<uint8_t> _buffer;
+  size_t _bufferStart;
+  size_t _bufferLength;
+  mutable std::atomic<uint64_t> _bytesRead;
+  mutable std::atomic<uint64_t> _readCount;
+
+#ifdef _WIN32
+  HANDLE _file;
+#else
+  int _fd;
+#endif
 };
 
-BinaryFileStream::BinaryFileStream(const std::string& path)
-    : impl(std::make_unique<IMPL>(path)) {}
+BinaryFileStream::BinaryFileStream(const std::string& path, size_t bufferSize)
+    : impl(std::make_unique<IMPL>(path, bufferSize)) {}
 
 BinaryFileStream::~BinaryFileStream() {}
 
 Error BinaryFileStream::Read(uint8_t* buf, size_t size) {
-  if (this->impl->_stream.is_open() == false) {
+  if (this->impl->IsOpen() == false) {
     return Error(ErrorCode::InvalidFileStream, "Invalid file stream");
   }
 
@@ -65,18 +86,65 @@ Error BinaryFileStream::Read(uint8_t* buf, size_t size) {
                  "Invalid read - Not enough data available");
   }
 
-  this->impl->_pos += size;
+  if (size == 0) {
+    return Error();
+  }
+
+  size_t pos = this->impl->_pos;
+
+  if (pos < this->impl->_bufferStart ||
+      pos + size > this->impl->_bufferStart + this->impl->_bufferLength) {
+    if (size >= this->impl->_buffer.size()) {
+      // too large to be buffered: read directly into the caller's buffer
+      Error err = this->impl->ReadFile(pos, buf, size);
+      if (err) return err;
 
-  Error err;
-  std::streamsize stream_size;
-  err = numeric_cast<std::streamsize>(stream_size, size);
-  if (err) return err;
+      this->impl->_pos += size;
 
-  this->impl->_stream.read(reinterpret_cast<char*>(buf), stream_size);
+      return Error();
+    }
+
+    size_t length =
+        std::min(this->impl->_buffer.size(), this->impl->_size - pos);
+
+    this->impl->_bufferLength = 0;
+
+    Error err = this->impl->ReadFile(pos, this->impl->_buffer.data(), length);
+    if (err) return err;
+
+    this->impl->_bufferStart = pos;
+    this->impl->_bufferLength = length;
+  }
+
+  memcpy(buf, this->impl->_buffer.data() + (pos - this->impl->_bufferStart),
+         size);
+
+  this->impl->_pos += size;
 
   return Error();
 }
 
+Error BinaryFileStream::ReadAt(uint64_t offset, uint8_t* buf,
+                               size_t size) const {
+  if (this->impl->IsOpen() == false) {
+    return Error(ErrorCode::InvalidFileStream, "Invalid file stream");
+  }
+
+  if (offset > this->impl->_size || size > this->impl->_size - offset) {
+    return Error(ErrorCode::InvalidReadSize,
+                 "Invalid read - Not enough data available");
+  }
+
+  if (size == 0) {
+    return Error();
+  }
+
+  // the read-ahead buffer belongs to the cursor, and is not shared here
+  return this->impl->ReadFile(offset, buf, size);
+}
+
+bool BinaryFileStream::IsReadAtThreadSafe() const { return true; }
+
 Error BinaryFileStream::Seek(std::streamoff offset, SeekDirection dir) {
   size_t pos;
 
@@ -119,45 +187,161 @@ Error BinaryFileStream::Seek(std::streamoff offset, SeekDirection dir) {
     return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
   }
 
+  // reads are positional, so the file itself is never repositioned
   this->impl->_pos = pos;
 
-  Error err;
-  std::streamsize stream_pos;
-  err = numeric_cast<std::streamsize>(stream_pos, pos);
-  if (err) return err;
-
-  this->impl->_stream.seekg(stream_pos, std::ios_base::beg);
-
   return Error();
 }
 
 size_t BinaryFileStream::Tell() const { return this->impl->_pos; }
 
-BinaryFileStream::IMPL::IMPL(const std::string& path)
-    : _path(path), _size(0), _pos(0) {
+size_t BinaryFileStream::Size() const { return this->impl->_size; }
+
+size_t BinaryFileStream::GetBufferSize() const {
+  return this->impl->_buffer.size();
+}
+
+uint64_t BinaryFileStream::GetBytesRead() const {
+  return this->impl->_bytesRead;
+}
+
+uint64_t BinaryFileStream::GetReadCount() const {
+  return this->impl->_readCount;
+}
+
 #ifdef _WIN32
-  this->_stream.open(ISOBMFF::StringToWideString(path), std::ios::binary);
-#else
-  this->_stream.open(path, std::ios::binary);
-#endif
 
-  if (this->_stream.good()) {
-    std::streamsize pos;
+BinaryFileStream::IMPL::IMPL(const std::string& path, size_t bufferSize)
+    : _path(path),
+      _size(0),
+      _pos(0),
+      _buffer(bufferSize),
+      _bufferStart(0),
+      _bufferLength(0),
+      _bytesRead(0),
+      _readCount(0),
+      _file(INVALID_HANDLE_VALUE) {
+  LARGE_INTEGER fileSize;
+
+  this->_file =
+      CreateFileW(ISOBMFF::StringToWideString(path).c_str(), GENERIC_READ,
+                  FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                  FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (this->_file == INVALID_HANDLE_VALUE) {
+    return;
+  }
 
-    this->_stream.seekg(0, std::ios_base::end);
+  if (GetFileSizeEx(this->_file, &fileSize) == FALSE ||
+      numeric_cast<size_t>(this->_size, fileSize.QuadPart)) {
+    CloseHandle(this->_file);
 
-    pos = this->_stream.tellg();
+    this->_file = INVALID_HANDLE_VALUE;
+    this->_size = 0;
+  }
+}
 
-    Error err;
-    err = numeric_cast<size_t>(this->_size, pos);
+BinaryFileStream::IMPL::~IMPL() {
+  if (this->_file != INVALID_HANDLE_VALUE) {
+    CloseHandle(this->_file);
+  }
+}
+
+bool BinaryFileStream::IMPL::IsOpen() const {
+  return this->_file != INVALID_HANDLE_VALUE;
+}
+
+Error BinaryFileStream::IMPL::ReadFile(uint64_t offset, uint8_t* buf,
+                                       size_t size) const {
+  while (size > 0) {
+    OVERLAPPED overlapped = {};
+    DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, MAXDWORD));
+    DWORD count = 0;
+
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    BOOL ok = ::ReadFile(this->_file, buf, chunk, &count, &overlapped);
+    this->_readCount++;
+
+    if (ok == FALSE || count == 0) {
+      return Error(ErrorCode::InvalidFileStream, "Cannot read from file");
+    }
+
+    this->_bytesRead += count;
+
+    buf += count;
+    offset += count;
+    size -= count;
+  }
+
+  return Error();
+}
 
-    this->_stream.seekg(0, std::ios_base::beg);
+#else
+
+BinaryFileStream::IMPL::IMPL(const std::string& path, size_t bufferSize)
+    : _path(path),
+      _size(0),
+      _pos(0),
+      _buffer(bufferSize),
+      _bufferStart(0),
+      _bufferLength(0),
+      _bytesRead(0),
+      _readCount(0),
+      _fd(-1) {
+  struct stat st;
+
+  this->_fd = open(path.c_str(), O_RDONLY);
+
+  if (this->_fd < 0) {
+    return;
+  }
+
+  if (fstat(this->_fd, &st) != 0 || S_ISREG(st.st_mode) == false ||
+      numeric_cast<size_t>(this->_size, st.st_size)) {
+    close(this->_fd);
+
+    this->_fd = -1;
+    this->_size = 0;
   }
 }
 
 BinaryFileStream::IMPL::~IMPL() {
-  if (this->_stream.is_open()) {
-    this->_stream.close();
+  if (this->_fd >= 0) {
+    close(this->_fd);
   }
 }
-}  // namespace ISOBMFF
\ No newline at end of file
+
+bool BinaryFileStream::IMPL::IsOpen() const { return this->_fd >= 0; }
+
+Error BinaryFileStream::IMPL::ReadFile(uint64_t offset, uint8_t* buf,
+                                       size_t size) const {
+  while (size > 0) {
+    off_t pos;
+    Error err = numeric_cast<off_t>(pos, offset);
+    if (err) return err;
+
+    ssize_t count = pread(this->_fd, buf, size, pos);
+    this->_readCount++;
+
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (count <= 0) {
+      return Error(ErrorCode::InvalidFileStream, "Cannot read from file");
+    }
+
+    this->_bytesRead += static_cast<uint64_t>(count);
+
+    buf += count;
+    offset += static_cast<uint64_t>(count);
+    size -= static_cast<size_t>(count);
+  }
+
+  return Error();
+}
+
+#endif
+}  // namespace ISOBMFF
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryMappedFileStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <string.h>
+
+#include <BinaryMappedFileStream.hpp>
+#include <Casts.hpp>
+#include <cmath>
+#include <vector>
+
+#ifdef _WIN32
+#include <WIN32.hpp>
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ISOBMFF {
+class BinaryMappedFileStream::IMPL {
+ public:
+  IMPL(const std::string& path);
+  ~IMPL();
+
+  std::string _path;
+  void* _mapping;
+  const uint8_t* _data;
+  size_t _size;
+  size_t _pos;
+
+#ifdef _WIN32
+  HANDLE _file;
+  HANDLE _fileMapping;
+#endif
+};
+
+BinaryMappedFileStream::BinaryMappedFileStream(const std::string& path)
+    : impl(std::make_unique<IMPL>(path)) {}
+
+BinaryMappedFileStream::~BinaryMappedFileStream() {}
+
+bool BinaryMappedFileStream::IsMapped() const {
+  return this->impl->_data != nullptr;
+}
+
+Error BinaryMappedFileStream::Read(uint8_t* buf, size_t size) {
+  if (this->impl->_data == nullptr) {
+    return Error(ErrorCode::InvalidFileStream, "Invalid file stream");
+  }
+
+  if (size > this->impl->_size - this->impl->_pos) {
+    return Error(ErrorCode::InvalidReadSize,
+                 "Invalid read - Not enough data available");
+  }
+
+  memcpy(buf, this->impl->_data + this->impl->_pos, size);
+
+  this->impl->_pos += size;
+
+  return Error();
+}
+
+Error BinaryMappedFileStream::ReadAt(uint64_t offset, uint8_t* buf,
+                                     size_t size) const {
+  if (this->impl->_data == nullptr) {
+    return Error(ErrorCode::InvalidFileStream, "Invalid file stream");
+  }
+
+  if (offset > this->impl->_size || size > this->impl->_size - offset) {
+    return Error(ErrorCode::InvalidReadSize,
+                 "Invalid read - Not enough data available");
+  }
+
+  memcpy(buf, this->impl->_data + offset, size);
+
+  return Error();
+}
+
+bool BinaryMappedFileStream::IsReadAtThreadSafe() const { return true; }
+
+const uint8_t* BinaryMappedFileStream::GetBytes() const {
+  return this->impl->_data;
+}
+
+Error BinaryMappedFileStream::Seek(std::streamoff offset, SeekDirection dir) {
+  size_t pos;
+
+  if (dir == SeekDirection::Begin) {
+    if (offset < 0) {
+      return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
+    }
+
+    Error err;
+    err = numeric_cast<size_t>(pos, offset);
+    if (err) return err;
+  } else if (dir == SeekDirection::End) {
+    if (offset > 0) {
+      return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
+    }
+
+    Error err;
+    size_t abs_offset;
+    err = numeric_cast<size_t>(abs_offset, std::abs(offset));
+    if (err) return err;
+
+    pos = this->impl->_size - abs_offset;
+  } else if (offset < 0) {
+    Error err;
+    size_t abs_offset;
+    err = numeric_cast<size_t>(abs_offset, std::abs(offset));
+    if (err) return err;
+
+    pos = this->impl->_pos - abs_offset;
+  } else {
+    Error err;
+    size_t offset_val;
+    err = numeric_cast<size_t>(offset_val, offset);
+    if (err) return err;
+
+    pos = this->impl->_pos + offset_val;
+  }
+
+  if (pos > this->impl->_size) {
+    return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
+  }
+
+  this->impl->_pos = pos;
+
+  return Error();
+}
+
+size_t BinaryMappedFileStream::Tell() const { return this->impl->_pos; }
+
+size_t BinaryMappedFileStream::Size() const { return this->impl->_size; }
+
+#ifdef _WIN32
+
+BinaryMappedFileStream::IMPL::IMPL(const std::string& path)
+    : _path(path),
+      _mapping(nullptr),
+      _data(nullptr),
+      _size(0),
+      _pos(0),
+      _file(INVALID_HANDLE_VALUE),
+      _fileMapping(nullptr) {
+  LARGE_INTEGER fileSize;
+
+  this->_file =
+      CreateFileW(ISOBMFF::StringToWideString(path).c_str(), GENERIC_READ,
+                  FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                  FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (this->_file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+
+  if (GetFileSizeEx(this->_file, &fileSize) == FALSE ||
+      fileSize.QuadPart <= 0) {
+    return;
+  }
+
+  size_t size;
+  Error err = numeric_cast<size_t>(size, fileSize.QuadPart);
+  if (err) return;
+
+  this->_fileMapping =
+      CreateFileMappingW(this->_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (this->_fileMapping == nullptr) {
+    return;
+  }
+
+  this->_mapping = MapViewOfFile(this->_fileMapping, FILE_MAP_READ, 0, 0, 0);
+
+  if (this->_mapping != nullptr) {
+    this->_data = static_cast<const uint8_t*>(this->_mapping);
+    this->_size = size;
+  }
+}
+
+BinaryMappedFileStream::IMPL::~IMPL() {
+  if (this->_mapping != nullptr) {
+    UnmapViewOfFile(this->_mapping);
+  }
+
+  if (this->_fileMapping != nullptr) {
+    CloseHandle(this->_fileMapping);
+  }
+
+  if (this->_file != INVALID_HANDLE_VALUE) {
+    CloseHandle(this->_file);
+  }
+}
+
+#else
+
+BinaryMappedFileStream::IMPL::IMPL(const std::string& path)
+    : _path(path), _mapping(nullptr), _data(nullptr), _size(0), _pos(0) {
+  struct stat st;
+  int fd;
+
+  fd = open(path.c_str(), O_RDONLY);
+
+  if (fd < 0) {
+    return;
+  }
+
+  /*
+   * The descriptor is not needed anymore once the mapping exists, and
+   * mmap() refuses empty files, which are left to the regular file
+   * stream.
+   */
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    size_t size;
+    Error err = numeric_cast<size_t>(size, st.st_size);
+
+    if (!err) {
+      void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (mapping != MAP_FAILED) {
+        this->_mapping = mapping;
+        this->_data = static_cast<const uint8_t*>(mapping);
+        this->_size = size;
+      }
+    }
+  }
+
+  close(fd);
+}
+
+BinaryMappedFileStream::IMPL::~IMPL() {
+  if (this->_mapping != nullptr) {
+    munmap(this->_mapping, this->_size);
+  }
+}
+
+#endif
+}  // namespace ISOBMFF
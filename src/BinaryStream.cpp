@@ -33,25 +33,210 @@
 #include <cmath>
 #include <fstream>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ISOBMFF_SSE2
+#elif defined(__ARM_NEON) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h>
+#define ISOBMFF_NEON
+#endif
+
 namespace ISOBMFF {
-bool BinaryStream::HasBytesAvailable() { return this->AvailableBytes() > 0; }
+/*
+ * Converts big-endian values read in place to the host byte order.
+ * The vector paths are only built for little-endian targets (x86, ARM
+ * with NEON), and the scalar tail builds each value from its bytes, so
+ * it is correct on any host.
+ */
+static void FromBigEndian16(uint16_t* values, size_t count) {
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(values);
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  const __m256i mask = _mm256_setr_epi8(
+      1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4,
+      7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+  for (; i + 16 <= count; i += 16) {
+    __m256i* p = reinterpret_cast<__m256i*>(bytes + i * 2);
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+  }
+#elif defined(__SSSE3__)
+  const __m128i mask =
+      _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
 
-size_t BinaryStream::AvailableBytes() {
-  size_t cur(this->Tell());
-  size_t pos;
+  for (; i + 8 <= count; i += 8) {
+    __m128i* p = reinterpret_cast<__m128i*>(bytes + i * 2);
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+#elif defined(ISOBMFF_SSE2)
+  for (; i + 8 <= count; i += 8) {
+    __m128i* p = reinterpret_cast<__m128i*>(bytes + i * 2);
+    __m128i v = _mm_loadu_si128(p);
+    _mm_storeu_si128(p,
+                     _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+  }
+#elif defined(ISOBMFF_NEON)
+  for (; i + 8 <= count; i += 8) {
+    uint8_t* p = bytes + i * 2;
+    vst1q_u8(p, vrev16q_u8(vld1q_u8(p)));
+  }
+#endif
+
+  for (; i < count; i++) {
+    const uint8_t* p = bytes + i * 2;
+    values[i] = static_cast<uint16_t>((p[0] << 8) | p[1]);
+  }
+}
 
-  this->Seek(0, SeekDirection::End);
+static void FromBigEndian32(uint32_t* values, size_t count) {
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(values);
+  size_t i = 0;
 
-  pos = this->Tell();
+#if defined(__AVX2__)
+  const __m256i mask = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6,
+      5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
 
+  for (; i + 8 <= count; i += 8) {
+    __m256i* p = reinterpret_cast<__m256i*>(bytes + i * 4);
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+  }
+#elif defined(__SSSE3__)
+  const __m128i mask =
+      _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+  for (; i + 4 <= count; i += 4) {
+    __m128i* p = reinterpret_cast<__m128i*>(bytes + i * 4);
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+#elif defined(ISOBMFF_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128i* p = reinterpret_cast<__m128i*>(bytes + i * 4);
+    __m128i v = _mm_loadu_si128(p);
+    // swap the 16-bit halves, then the bytes within each half
+    v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)),
+                            _MM_SHUFFLE(2, 3, 0, 1));
+    _mm_storeu_si128(p,
+                     _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+  }
+#elif defined(ISOBMFF_NEON)
+  for (; i + 4 <= count; i += 4) {
+    uint8_t* p = bytes + i * 4;
+    vst1q_u8(p, vrev32q_u8(vld1q_u8(p)));
+  }
+#endif
+
+  for (; i < count; i++) {
+    const uint8_t* p = bytes + i * 4;
+    values[i] = (static_cast<uint32_t>(p[0]) << 24) |
+                (static_cast<uint32_t>(p[1]) << 16) |
+                (static_cast<uint32_t>(p[2]) << 8) |
+                static_cast<uint32_t>(p[3]);
+  }
+}
+
+static void FromBigEndian64(uint64_t* values, size_t count) {
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(values);
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  const __m256i mask = _mm256_setr_epi8(
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2,
+      1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+  for (; i + 4 <= count; i += 4) {
+    __m256i* p = reinterpret_cast<__m256i*>(bytes + i * 8);
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+  }
+#elif defined(__SSSE3__)
+  const __m128i mask =
+      _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+  for (; i + 2 <= count; i += 2) {
+    __m128i* p = reinterpret_cast<__m128i*>(bytes + i * 8);
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+#elif defined(ISOBMFF_NEON)
+  for (; i + 2 <= count; i += 2) {
+    uint8_t* p = bytes + i * 8;
+    vst1q_u8(p, vrev64q_u8(vld1q_u8(p)));
+  }
+#endif
+
+  for (; i < count; i++) {
+    const uint8_t* p = bytes + i * 8;
+    uint64_t value = 0;
+    for (size_t j = 0; j < 8; j++) {
+      value = (value << 8) | p[j];
+    }
+    values[i] = value;
+  }
+}
+
+Error BinaryStream::ReadAt(uint64_t offset, uint8_t* buf, size_t size) const {
+  // the cursor is restored, but callers needing several threads have to
+  // check IsReadAtThreadSafe() and read on their own thread otherwise
+  BinaryStream& stream = const_cast<BinaryStream&>(*(this));
+  size_t cur(this->Tell());
+  std::streamoff pos;
   Error err;
-  std::streamoff offset;
-  err = numeric_cast<std::streamoff>(offset, cur);
+
+  if (offset > this->Size() || size > this->Size() - offset) {
+    return Error(ErrorCode::InsufficientData,
+                 "Invalid read - Not enough data available");
+  }
+
+  err = numeric_cast<std::streamoff>(pos, offset);
+  if (err) return err;
+
+  err = stream.Seek(pos, SeekDirection::Begin);
   if (!err) {
-    this->Seek(offset, SeekDirection::Begin);
+    err = stream.Read(buf, size);
+  }
+
+  if (!numeric_cast<std::streamoff>(pos, cur)) {
+    stream.Seek(pos, SeekDirection::Begin);
+  }
+
+  return err;
+}
+
+bool BinaryStream::IsReadAtThreadSafe() const { return false; }
+
+const uint8_t* BinaryStream::GetBytes() const { return nullptr; }
+
+size_t BinaryStream::Size() const {
+  // the cursor is restored, so the stream is left as it was
+  BinaryStream& stream = const_cast<BinaryStream&>(*(this));
+  size_t cur(this->Tell());
+  size_t size;
+  std::streamoff offset;
+
+  stream.Seek(0, SeekDirection::End);
+
+  size = this->Tell();
+
+  if (!numeric_cast<std::streamoff>(offset, cur)) {
+    stream.Seek(offset, SeekDirection::Begin);
   }
 
-  return pos - cur;
+  return size;
+}
+
+bool BinaryStream::HasBytesAvailable() { return this->AvailableBytes() > 0; }
+
+size_t BinaryStream::AvailableBytes() {
+  size_t size(this->Size());
+  size_t pos(this->Tell());
+
+  return (pos < size) ? size - pos : 0;
 }
 
 Error BinaryStream::Seek(std::streamoff offset) {
@@ -59,15 +244,32 @@ Error BinaryStream::Seek(std::streamoff offset) {
 }
 
 Error BinaryStream::Get(uint8_t* buf, uint64_t pos, size_t length) {
-  size_t cur = this->Tell();
+  if (this->IsReadAtThreadSafe()) {
+    return this->ReadAt(this->Tell() + pos, buf, length);
+  }
 
-  Error err = this->Seek(pos, SeekDirection::Current);
-  if (err) return err;
+  size_t cur(this->Tell());
+  std::streamoff offset;
+  Error err;
 
-  err = this->Read(buf, length);
+  if (pos > this->AvailableBytes() || length > this->AvailableBytes() - pos) {
+    return Error(ErrorCode::InsufficientData,
+                 "Invalid read - Not enough data available");
+  }
+
+  err = numeric_cast<std::streamoff>(offset, pos);
   if (err) return err;
 
-  return this->Seek(cur, SeekDirection::Begin);
+  err = this->Seek(offset, SeekDirection::Current);
+  if (!err) {
+    err = this->Read(buf, length);
+  }
+
+  if (!numeric_cast<std::streamoff>(offset, cur)) {
+    this->Seek(offset, SeekDirection::Begin);
+  }
+
+  return err;
 }
 
 Error BinaryStream::Read(std::vector<uint8_t>& data, size_t size) {
@@ -203,6 +405,63 @@ Error BinaryStream::ReadBigEndianInt32(int32_t& value) {
   return Error();
 }
 
+Error BinaryStream::ReadBigEndianUInt16Array(uint16_t* values, size_t count) {
+  if (count > this->AvailableBytes() / sizeof(uint16_t)) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  if (count == 0) {
+    return Error();
+  }
+
+  Error err =
+      this->Read(reinterpret_cast<uint8_t*>(values), count * sizeof(uint16_t));
+  if (err) return err;
+
+  FromBigEndian16(values, count);
+
+  return Error();
+}
+
+Error BinaryStream::ReadBigEndianUInt32Array(uint32_t* values, size_t count) {
+  if (count > this->AvailableBytes() / sizeof(uint32_t)) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  if (count == 0) {
+    return Error();
+  }
+
+  Error err =
+      this->Read(reinterpret_cast<uint8_t*>(values), count * sizeof(uint32_t));
+  if (err) return err;
+
+  FromBigEndian32(values, count);
+
+  return Error();
+}
+
+Error BinaryStream::ReadBigEndianUInt64Array(uint64_t* values, size_t count) {
+  if (count > this->AvailableBytes() / sizeof(uint64_t)) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  if (count == 0) {
+    return Error();
+  }
+
+  Error err =
+      this->Read(reinterpret_cast<uint8_t*>(values), count * sizeof(uint64_t));
+  if (err) return err;
+
+  FromBigEndian64(values, count);
+
+  return Error();
+}
+
 Error BinaryStream::ReadLittleEndianUInt32(uint32_t& value) {
   uint8_t c[4] = {0, 0, 0, 0};
   uint32_t n1;
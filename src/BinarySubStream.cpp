@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinarySubStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <BinarySubStream.hpp>
+#include <Casts.hpp>
+#include <cmath>
+
+namespace ISOBMFF {
+class BinarySubStream::IMPL {
+ public:
+  IMPL(BinaryStream& source, size_t offset, size_t length);
+  ~IMPL();
+
+  BinaryStream& _source;
+  size_t _offset;
+  size_t _length;
+  size_t _pos;
+};
+
+static BinaryStream& SourceOf(BinaryStream& stream) {
+  BinarySubStream* sub = dynamic_cast<BinarySubStream*>(&stream);
+
+  return (sub != nullptr) ? sub->GetSource() : stream;
+}
+
+static size_t OffsetOf(BinaryStream& stream) {
+  BinarySubStream* sub = dynamic_cast<BinarySubStream*>(&stream);
+
+  return (sub != nullptr) ? sub->GetOffset() : 0;
+}
+
+BinarySubStream::BinarySubStream(BinaryStream& stream, size_t offset,
+                                 size_t length)
+    : impl(std::make_unique<IMPL>(SourceOf(stream), OffsetOf(stream) + offset,
+                                  length)) {}
+
+BinarySubStream::~BinarySubStream() {}
+
+Error BinarySubStream::Read(uint8_t* buf, size_t size) {
+  if (size > this->impl->_length - this->impl->_pos) {
+    return Error(ErrorCode::InsufficientData,
+                 "Invalid read - Not enough data available");
+  }
+
+  size_t pos = this->impl->_offset + this->impl->_pos;
+  Error err;
+
+  /*
+   * The source stream is shared with the parent and child windows, so
+   * only seek when someone else moved it.
+   */
+  if (this->impl->_source.Tell() != pos) {
+    err = this->impl->_source.Seek(pos, SeekDirection::Begin);
+    if (err) return err;
+  }
+
+  err = this->impl->_source.Read(buf, size);
+  if (err) return err;
+
+  this->impl->_pos += size;
+
+  return Error();
+}
+
+Error BinarySubStream::ReadAt(uint64_t offset, uint8_t* buf,
+                              size_t size) const {
+  if (offset > this->impl->_length || size > this->impl->_length - offset) {
+    return Error(ErrorCode::InsufficientData,
+                 "Invalid read - Not enough data available");
+  }
+
+  return this->impl->_source.ReadAt(this->impl->_offset + offset, buf, size);
+}
+
+bool BinarySubStream::IsReadAtThreadSafe() const {
+  return this->impl->_source.IsReadAtThreadSafe();
+}
+
+const uint8_t* BinarySubStream::GetBytes() const {
+  const uint8_t* bytes = this->impl->_source.GetBytes();
+
+  return (bytes != nullptr) ? bytes + this->impl->_offset : nullptr;
+}
+
+Error BinarySubStream::Seek(std::streamoff offset, SeekDirection dir) {
+  size_t pos;
+
+  if (dir == SeekDirection::Begin) {
+    if (offset < 0) {
+      return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
+    }
+
+    Error err;
+    err = numeric_cast<size_t>(pos, offset);
+    if (err) return err;
+  } else if (dir == SeekDirection::End) {
+    if (offset > 0) {
+      return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
+    }
+
+    Error err;
+    size_t abs_offset;
+    err = numeric_cast<size_t>(abs_offset, std::abs(offset));
+    if (err) return err;
+
+    pos = this->impl->_length - abs_offset;
+  } else if (offset < 0) {
+    Error err;
+    size_t abs_offset;
+    err = numeric_cast<size_t>(abs_offset, std::abs(offset));
+    if (err) return err;
+
+    pos = this->impl->_pos - abs_offset;
+  } else {
+    Error err;
+    size_t offset_val;
+    err = numeric_cast<size_t>(offset_val, offset);
+    if (err) return err;
+
+    pos = this->impl->_pos + offset_val;
+  }
+
+  if (pos > this->impl->_length) {
+    return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
+  }
+
+  this->impl->_pos = pos;
+
+  return Error();
+}
+
+size_t BinarySubStream::Tell() const { return this->impl->_pos; }
+
+size_t BinarySubStream::Size() const { return this->impl->_length; }
+
+BinaryStream& BinarySubStream::GetSource() const {
+  return this->impl->_source;
+}
+
+size_t BinarySubStream::GetOffset() const { return this->impl->_offset; }
+
+size_t BinarySubStream::GetLength() const { return this->impl->_length; }
+
+BinarySubStream::IMPL::IMPL(BinaryStream& source, size_t offset,
+                            size_t length)
+    : _source(source), _offset(offset), _length(length), _pos(0) {}
+
+BinarySubStream::IMPL::~IMPL() {}
+}  // namespace ISOBMFF
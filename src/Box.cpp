@@ -28,13 +28,14 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <Box.hpp>
 #include <DisplayableObjectContainer.hpp>
 #include <Parser.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class Box::IMPL {
+class Box::IMPL : public Arena::Object {
  public:
   IMPL(const std::string& name = "????");
   IMPL(const IMPL& o);
@@ -43,6 +44,13 @@ class Box::IMPL {
   std::string _name;
   std::vector<uint8_t> _data;
   bool _hasData;
+  uint64_t _offset;
+  uint64_t _headerSize;
+  uint64_t _size;
+  std::function<Error(Box&)> _loader;
+
+  // kept after a failed load, which is not retried
+  Error _loadError;
 };
 
 Box::Box(const std::string& name) : impl(std::make_unique<IMPL>(name)) {}
@@ -80,15 +88,57 @@ Error Box::ReadData(Parser& parser, BinaryStream& stream) {
 
 std::vector<uint8_t> Box::GetData() const { return this->impl->_data; }
 
+uint64_t Box::GetOffset() const { return this->impl->_offset; }
+
+uint64_t Box::GetHeaderSize() const { return this->impl->_headerSize; }
+
+uint64_t Box::GetSize() const { return this->impl->_size; }
+
+void Box::SetOffset(uint64_t value) { this->impl->_offset = value; }
+
+void Box::SetHeaderSize(uint64_t value) { this->impl->_headerSize = value; }
+
+void Box::SetSize(uint64_t value) { this->impl->_size = value; }
+
+void Box::Defer(const std::function<Error(Box&)>& loader) {
+  this->impl->_loader = loader;
+}
+
+bool Box::IsLoaded() const {
+  return this->impl->_loader == nullptr && !this->impl->_loadError;
+}
+
+Error Box::Load() {
+  if (this->impl->_loader == nullptr) {
+    return this->impl->_loadError;
+  }
+
+  // the loader is released first, so it runs once even if reading fails
+  std::function<Error(Box&)> loader(std::move(this->impl->_loader));
+  this->impl->_loader = nullptr;
+
+  this->impl->_loadError = loader(*(this));
+
+  return this->impl->_loadError;
+}
+
 std::vector<std::pair<std::string, std::string> >
 Box::GetDisplayableProperties() const {
   return {};
 }
 
-Box::IMPL::IMPL(const std::string& name) : _name(name), _hasData(false) {}
+Box::IMPL::IMPL(const std::string& name)
+    : _name(name), _hasData(false), _offset(0), _headerSize(0), _size(0) {}
 
 Box::IMPL::IMPL(const IMPL& o)
-    : _name(o._name), _data(o._data), _hasData(o._hasData) {}
+    : _name(o._name),
+      _data(o._data),
+      _hasData(o._hasData),
+      _offset(o._offset),
+      _headerSize(o._headerSize),
+      _size(o._size),
+      _loader(o._loader),
+      _loadError(o._loadError) {}
 
 Box::IMPL::~IMPL() {}
 }  // namespace ISOBMFF
@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <CDSC.hpp>
 
 namespace ISOBMFF {
-class CDSC::IMPL {
+class CDSC::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
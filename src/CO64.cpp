@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        CO64.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <Arena.hpp>
+#include <CO64.hpp>
+#include <Parser.hpp>
+#include <cstdint>
+
+namespace ISOBMFF {
+class CO64::IMPL : public Arena::Object {
+ public:
+  IMPL();
+  IMPL(const IMPL& o);
+  ~IMPL();
+
+  std::vector<uint64_t> _chunk_offset;
+};
+
+CO64::CO64() : FullBox("co64"), impl(std::make_unique<IMPL>()) {}
+
+CO64::CO64(const CO64& o)
+    : FullBox(o), impl(std::make_unique<IMPL>(*(o.impl))) {}
+
+CO64::CO64(CO64&& o) noexcept : FullBox(std::move(o)), impl(std::move(o.impl)) {
+  o.impl = nullptr;
+}
+
+CO64::~CO64() {}
+
+CO64& CO64::operator=(CO64 o) {
+  FullBox::operator=(o);
+  swap(*(this), o);
+
+  return *(this);
+}
+
+void swap(CO64& o1, CO64& o2) {
+  using std::swap;
+
+  swap(static_cast<FullBox&>(o1), static_cast<FullBox&>(o2));
+  swap(o1.impl, o2.impl);
+}
+
+Error CO64::ReadData(Parser& parser, BinaryStream& stream) {
+  Error err;
+
+  err = FullBox::ReadData(parser, stream);
+  if (err) return err;
+
+  uint32_t entry_count;
+  err = stream.ReadBigEndianUInt32(entry_count);
+  if (err) return err;
+
+  if (entry_count > stream.AvailableBytes() / 8) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  std::vector<uint64_t> entries(entry_count);
+  err = stream.ReadBigEndianUInt64Array(entries.data(), entries.size());
+  if (err) return err;
+
+  this->impl->_chunk_offset = std::move(entries);
+
+  return Error();
+}
+
+std::vector<std::pair<std::string, std::string> >
+CO64::GetDisplayableProperties() const {
+  auto props(FullBox::GetDisplayableProperties());
+
+  for (size_t index = 0; index < this->GetEntryCount(); index++) {
+    props.push_back(
+        {"Chunk Offset", std::to_string(this->GetChunkOffset(index))});
+  }
+
+  return props;
+}
+
+size_t CO64::GetEntryCount() const { return this->impl->_chunk_offset.size(); }
+
+uint64_t CO64::GetChunkOffset(size_t index) const {
+  return this->impl->_chunk_offset[index];
+}
+
+CO64::IMPL::IMPL() {}
+
+CO64::IMPL::IMPL(const IMPL& o) : _chunk_offset(o._chunk_offset) {}
+
+CO64::IMPL::~IMPL() {}
+}  // namespace ISOBMFF
@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <COLR.hpp>
 #include <iomanip>
 #include <sstream>
 
 namespace ISOBMFF {
-class COLR::IMPL {
+class COLR::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -28,20 +28,21 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <CTTS.hpp>
 #include <Parser.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF {
-class CTTS::IMPL {
+class CTTS::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
   ~IMPL();
 
-  std::vector<uint32_t> _sample_count;
-  std::vector<int32_t> _sample_offset;
+  // interleaved (sample_count, sample_offset) pairs, as stored in the box
+  std::vector<uint32_t> _entries;
 };
 
 CTTS::CTTS() : FullBox("ctts"), impl(std::make_unique<IMPL>()) {}
@@ -79,34 +80,36 @@ Error CTTS::ReadData(Parser& parser, BinaryStream& stream) {
   err = stream.ReadBigEndianUInt32(entry_count);
   if (err) return err;
 
-  for (uint32_t i = 0; i < entry_count; i++) {
-    uint32_t temp;
-    err = stream.ReadBigEndianUInt32(temp);
-    if (err) return err;
-    this->impl->_sample_count.push_back(temp);
-
-    // CTTS.sample_offset changed sign in version 1, from uint32_t to int32_t.
-    // Using both unsigned and signed values is cumbersome to operate.
-    // Moreover, it may not be accurate anyway: Apple MOV files are known to
-    // use negative numbers with version == 0
-    // [link](https://trac.ffmpeg.org/ticket/7497).
-    // ```
-    // if (version==0) {
-    //   for (i=0; i < entry_count; i++) {
-    //     unsigned int(32) sample_count;
-    //     unsigned int(32) sample_offset;
-    //   }
-    // } else if (version == 1) {
-    //   for (i=0; i < entry_count; i++) {
-    //     unsigned int(32) sample_count;
-    //     signed int(32) sample_offset;
-    //   }
-    // }
-    // ```
-    err = stream.ReadBigEndianUInt32(temp);
-    if (err) return err;
-    this->impl->_sample_offset.push_back(static_cast<int32_t>(temp));
+  if (entry_count > stream.AvailableBytes() / 8) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
   }
+
+  // CTTS.sample_offset changed sign in version 1, from uint32_t to int32_t.
+  // Using both unsigned and signed values is cumbersome to operate.
+  // Moreover, it may not be accurate anyway: Apple MOV files are known to
+  // use negative numbers with version == 0
+  // [link](https://trac.ffmpeg.org/ticket/7497).
+  // ```
+  // if (version==0) {
+  //   for (i=0; i < entry_count; i++) {
+  //     unsigned int(32) sample_count;
+  //     unsigned int(32) sample_offset;
+  //   }
+  // } else if (version == 1) {
+  //   for (i=0; i < entry_count; i++) {
+  //     unsigned int(32) sample_count;
+  //     signed int(32) sample_offset;
+  //   }
+  // }
+  // ```
+  // Offsets are therefore kept as read, and always returned as signed.
+  std::vector<uint32_t> entries(static_cast<size_t>(entry_count) * 2);
+  err = stream.ReadBigEndianUInt32Array(entries.data(), entries.size());
+  if (err) return err;
+
+  this->impl->_entries = std::move(entries);
+
   return Error();
 }
 
@@ -124,22 +127,19 @@ CTTS::GetDisplayableProperties() const {
   return props;
 }
 
-size_t CTTS::GetEntryCount() const { return this->impl->_sample_count.size(); }
+size_t CTTS::GetEntryCount() const { return this->impl->_entries.size() / 2; }
 
 uint32_t CTTS::GetSampleCount(size_t index) const {
-  return this->impl->_sample_count[index];
+  return this->impl->_entries[index * 2];
 }
 
 int32_t CTTS::GetSampleOffset(size_t index) const {
-  return this->impl->_sample_offset[index];
+  return static_cast<int32_t>(this->impl->_entries[index * 2 + 1]);
 }
 
 CTTS::IMPL::IMPL() {}
 
-CTTS::IMPL::IMPL(const IMPL& o) {
-  this->_sample_count = o._sample_count;
-  this->_sample_offset = o._sample_offset;
-}
+CTTS::IMPL::IMPL(const IMPL& o) { this->_entries = o._entries; }
 
 CTTS::IMPL::~IMPL() {}
 }  // namespace ISOBMFF
@@ -41,6 +41,7 @@ void Container::WriteBoxes(const std::vector<std::shared_ptr<Box> >& boxes,
     os << std::endl << i << "{" << std::endl;
 
     for (const auto& box : boxes) {
+      box->Load();
       box->WriteDescription(os, indentLevel + 1);
 
       os << std::endl;
@@ -60,6 +61,7 @@ std::vector<std::shared_ptr<Box> > Container::GetBoxes(
 
   for (const auto& box : this->GetBoxes()) {
     if (box->GetName() == name) {
+      box->Load();
       boxes.push_back(box);
     }
   }
@@ -70,6 +72,7 @@ std::vector<std::shared_ptr<Box> > Container::GetBoxes(
 std::shared_ptr<Box> Container::GetBox(const std::string& name) const {
   for (const auto& box : this->GetBoxes()) {
     if (box->GetName() == name) {
+      box->Load();
       return box;
     }
   }
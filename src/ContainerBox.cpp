@@ -28,12 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
-#include <BinaryDataStream.hpp>
+#include <Arena.hpp>
 #include <ContainerBox.hpp>
 #include <Parser.hpp>
 
 namespace ISOBMFF {
-class ContainerBox::IMPL {
+class ContainerBox::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -70,82 +70,9 @@ void swap(ContainerBox& o1, ContainerBox& o2) {
 }
 
 Error ContainerBox::ReadData(Parser& parser, BinaryStream& stream) {
-  uint64_t length;
-  std::string name;
-  std::shared_ptr<Box> box;
-  BinaryDataStream* content;
-
   this->impl->_boxes.clear();
 
-  while (stream.HasBytesAvailable()) {
-    (void)parser;
-
-    Error err;
-    uint32_t temp32;
-    err = stream.ReadBigEndianUInt32(temp32);
-    if (err) return err;
-    length = temp32;
-
-    if (length == 0 && !stream.HasBytesAvailable()) {
-      break;
-    }
-
-    err = stream.ReadFourCC(name);
-    if (err) return err;
-
-    content = nullptr;
-
-    if (length == 1) {
-      err = stream.ReadBigEndianUInt64(length);
-      if (err) return err;
-
-      if (length > (std::numeric_limits<size_t>::max)() ||
-          (name == "mdat" &&
-           !parser.HasOption(Parser::Options::DoNotSkipMDATData))) {
-        err = stream.Seek(length - 16, BinaryStream::SeekDirection::Current);
-        if (err) return err;
-      } else {
-        std::vector<uint8_t> data;
-        err = stream.Read(data, static_cast<size_t>(length) - 16);
-        if (err) return err;
-
-        content = new BinaryDataStream(data);
-      }
-    } else {
-      if (name == "mdat" &&
-          !parser.HasOption(Parser::Options::DoNotSkipMDATData)) {
-        err = stream.Seek(length - 8, BinaryStream::SeekDirection::Current);
-        if (err) return err;
-      } else {
-        std::vector<uint8_t> data;
-        err = stream.Read(data, static_cast<uint32_t>(length) - 8);
-        if (err) return err;
-
-        content = new BinaryDataStream(data);
-      }
-    }
-
-    box = parser.CreateBox(name);
-
-    if (box != nullptr) {
-      if (content) {
-        Error box_err = box->ReadData(parser, *content);
-        if (box_err) {
-          delete (content);
-          std::cerr << "Error while reading box " << name << ": "
-                    << box_err.GetMessage() << std::endl;
-          return box_err;
-        }
-      }
-
-      this->AddBox(box);
-    }
-    if (content) {
-      delete (content);
-    }
-  }
-
-  return Error();
+  return parser.ReadChildren(*(this), stream);
 }
 
 void ContainerBox::AddBox(std::shared_ptr<Box> box) {
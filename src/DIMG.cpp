@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <DIMG.hpp>
 
 namespace ISOBMFF {
-class DIMG::IMPL {
+class DIMG::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
 #include <DREF.hpp>
+#include <Parser.hpp>
 #include <iostream>
 
 namespace ISOBMFF {
-class DREF::IMPL {
+class DREF::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL &o);
@@ -68,7 +69,6 @@ void swap(DREF &o1, DREF &o2) {
 }
 
 Error DREF::ReadData(Parser &parser, BinaryStream &stream) {
-  ContainerBox container("????");
   Error err;
 
   err = FullBox::ReadData(parser, stream);
@@ -78,10 +78,10 @@ Error DREF::ReadData(Parser &parser, BinaryStream &stream) {
   err = stream.ReadBigEndianUInt32(temp);
   if (err) return err;
 
-  err = container.ReadData(parser, stream);
-  if (err) return err;
+  this->impl->_boxes.clear();
 
-  this->impl->_boxes = container.GetBoxes();
+  err = parser.ReadChildren(*(this), stream);
+  if (err) return err;
 
   return Error();
 }
@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <FRMA.hpp>
 #include <Parser.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class FRMA::IMPL {
+class FRMA::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
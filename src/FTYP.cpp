@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <FTYP.hpp>
 #include <Parser.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class FTYP::IMPL {
+class FTYP::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
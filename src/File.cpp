@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <File.hpp>
 
 namespace ISOBMFF {
-class File::IMPL {
+class File::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
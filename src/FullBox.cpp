@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <FullBox.hpp>
 #include <Parser.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class FullBox::IMPL {
+class FullBox::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -28,13 +28,14 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <HDLR.hpp>
 #include <Parser.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF {
-class HDLR::IMPL {
+class HDLR::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
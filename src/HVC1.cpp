@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
 #include <HVC1.hpp>
+#include <Parser.hpp>
 
 namespace ISOBMFF {
-class HVC1::IMPL {
+class HVC1::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -76,7 +77,6 @@ void swap(HVC1& o1, HVC1& o2) {
 }
 
 Error HVC1::ReadData(Parser& parser, BinaryStream& stream) {
-  ContainerBox container("????");
   Error err;
 
   uint8_t temp8;
@@ -153,10 +153,10 @@ Error HVC1::ReadData(Parser& parser, BinaryStream& stream) {
   err = stream.ReadBigEndianUInt16(temp16);
   if (err) return err;
 
-  err = container.ReadData(parser, stream);
-  if (err) return err;
+  this->impl->_boxes.clear();
 
-  this->impl->_boxes = container.GetBoxes();
+  err = parser.ReadChildren(*(this), stream);
+  if (err) return err;
 
   return Error();
 }
@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <HVCC.hpp>
 #include <Parser.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class HVCC::IMPL {
+class HVCC::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
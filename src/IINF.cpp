@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
 #include <IINF.hpp>
+#include <Parser.hpp>
 
 namespace ISOBMFF {
-class IINF::IMPL {
+class IINF::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -67,7 +68,6 @@ void swap(IINF& o1, IINF& o2) {
 }
 
 Error IINF::ReadData(Parser& parser, BinaryStream& stream) {
-  ContainerBox container("????");
   Error err;
 
   err = FullBox::ReadData(parser, stream);
@@ -83,16 +83,11 @@ Error IINF::ReadData(Parser& parser, BinaryStream& stream) {
     if (err) return err;
   }
 
-  err = container.ReadData(parser, stream);
-  if (err) return err;
-
+  // boxes other than item infos are ignored (see AddBox)
   this->impl->_entries.clear();
 
-  for (const auto& box : container.GetBoxes()) {
-    if (dynamic_cast<INFE*>(box.get()) != nullptr) {
-      this->AddEntry(std::dynamic_pointer_cast<INFE>(box));
-    }
-  }
+  err = parser.ReadChildren(*(this), stream);
+  if (err) return err;
 
   return Error();
 }
@@ -109,6 +104,10 @@ void IINF::AddEntry(std::shared_ptr<INFE> entry) {
 }
 
 std::vector<std::shared_ptr<INFE> > IINF::GetEntries() const {
+  for (const auto& entry : this->impl->_entries) {
+    entry->Load();
+  }
+
   return this->impl->_entries;
 }
 
@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <ILOC.hpp>
 
 namespace ISOBMFF {
-class ILOC::IMPL {
+class ILOC::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <INFE.hpp>
 #include <Parser.hpp>
 
 namespace ISOBMFF {
-class INFE::IMPL {
+class INFE::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
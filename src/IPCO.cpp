@@ -40,6 +40,8 @@ std::shared_ptr<Box> IPCO::GetPropertyAtIndex(size_t index) const {
     return nullptr;
   }
 
+  boxes[index]->Load();
+
   return boxes[index];
 }
 
@@ -58,6 +60,8 @@ std::shared_ptr<Box> IPCO::GetProperty(
     return nullptr;
   }
 
+  boxes[index - 1]->Load();
+
   return boxes[index - 1];
 }
 
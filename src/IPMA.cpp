@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <IPMA.hpp>
 
 namespace ISOBMFF {
-class IPMA::IMPL {
+class IPMA::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -28,12 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
 #include <IREF.hpp>
 #include <Parser.hpp>
 
 namespace ISOBMFF {
-class IREF::IMPL {
+class IREF::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -68,22 +68,19 @@ void swap(IREF& o1, IREF& o2) {
 }
 
 Error IREF::ReadData(Parser& parser, BinaryStream& stream) {
-  ContainerBox container("????");
   Error err;
 
   err = FullBox::ReadData(parser, stream);
   if (err) return err;
 
-  parser.SetInfo("iref", this);
+  // references read the version of this box
+  parser.GetContext().ExposeBox();
 
-  err = container.ReadData(parser, stream);
-
-  parser.SetInfo("iref", nullptr);
+  this->impl->_boxes.clear();
 
+  err = parser.ReadChildren(*(this), stream);
   if (err) return err;
 
-  this->impl->_boxes = container.GetBoxes();
-
   return Error();
 }
 
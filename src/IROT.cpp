@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <IROT.hpp>
 #include <Parser.hpp>
 
 namespace ISOBMFF {
-class IROT::IMPL {
+class IROT::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
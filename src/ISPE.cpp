@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <ISPE.hpp>
 
 namespace ISOBMFF {
-class ISPE::IMPL {
+class ISPE::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -0,0 +1,381 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        IncrementalParser.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <BinaryDataStream.hpp>
+#include <IncrementalParser.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace ISOBMFF {
+class IncrementalParser::IMPL {
+ public:
+  IMPL();
+  IMPL(const Parser& parser);
+  IMPL(const IMPL& o);
+  ~IMPL();
+
+  Error Consume(const uint8_t* data, size_t size, size_t& used);
+  Error ReadHeader(const uint8_t* header);
+  Error Complete(const uint8_t* data, uint64_t size);
+  void Clear();
+
+  Parser _parser;
+  std::shared_ptr<File> _file;
+  BoxHandler _handler;
+  Error _error;
+  uint64_t _appended;
+
+  // the box being received: its offset in the file, and the bytes
+  // received so far, which are kept unless the box is skipped
+  uint64_t _offset;
+  uint64_t _received;
+  std::vector<uint8_t> _pending;
+
+  // once the box header is received
+  bool _hasHeader;
+  std::string _name;
+  uint64_t _headerSize;
+  uint64_t _size;
+  bool _toEnd;
+  std::shared_ptr<Box> _skipped;
+};
+
+static uint32_t BigEndianUInt32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) |
+         (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+// box headers are 8 bytes long, or 16 with a 64-bit size
+static size_t HeaderLength(const uint8_t* bytes, size_t size) {
+  return (size >= 4 && BigEndianUInt32(bytes) == 1) ? 16 : 8;
+}
+
+IncrementalParser::IncrementalParser() : impl(std::make_unique<IMPL>()) {}
+
+IncrementalParser::IncrementalParser(const Parser& parser)
+    : impl(std::make_unique<IMPL>(parser)) {}
+
+IncrementalParser::IncrementalParser(const IncrementalParser& o)
+    : impl(std::make_unique<IMPL>(*(o.impl))) {}
+
+IncrementalParser::IncrementalParser(IncrementalParser&& o) noexcept
+    : impl(std::move(o.impl)) {
+  o.impl = nullptr;
+}
+
+IncrementalParser::~IncrementalParser() {}
+
+IncrementalParser& IncrementalParser::operator=(IncrementalParser o) {
+  swap(*(this), o);
+
+  return *(this);
+}
+
+void swap(IncrementalParser& o1, IncrementalParser& o2) {
+  using std::swap;
+
+  swap(o1.impl, o2.impl);
+}
+
+Error IncrementalParser::Append(const uint8_t* data, size_t size) {
+  if (this->impl->_error) {
+    return this->impl->_error;
+  }
+
+  while (size > 0) {
+    size_t used = 0;
+
+    Error err = this->impl->Consume(data, size, used);
+    this->impl->_appended += used;
+
+    if (err) {
+      this->impl->_error = err;
+      return err;
+    }
+
+    data += used;
+    size -= used;
+  }
+
+  return Error();
+}
+
+Error IncrementalParser::Append(const std::vector<uint8_t>& data) {
+  return this->Append(data.data(), data.size());
+}
+
+Error IncrementalParser::Append(std::istream& stream) {
+  std::vector<uint8_t> buffer(ChunkSize);
+
+  while (stream.good()) {
+    stream.read(reinterpret_cast<char*>(buffer.data()),
+                static_cast<std::streamsize>(buffer.size()));
+
+    Error err =
+        this->Append(buffer.data(), static_cast<size_t>(stream.gcount()));
+    if (err) return err;
+  }
+
+  if (stream.bad()) {
+    return Error(ErrorCode::CannotReadFile, "Cannot read file");
+  }
+
+  return Error();
+}
+
+Error IncrementalParser::Finish() {
+  if (this->impl->_error) {
+    return this->impl->_error;
+  }
+
+  Error err;
+
+  if (this->impl->_hasHeader && this->impl->_toEnd) {
+    err = this->impl->Complete(this->impl->_pending.data(),
+                               this->impl->_received);
+  } else if (this->impl->_hasHeader) {
+    err = Error(ErrorCode::InsufficientData,
+                "Insufficient data available for read");
+  } else if (this->impl->_pending.empty() == false) {
+    // QuickTime allows a 32-bit terminator at the end of files
+    if (this->impl->_pending.size() == 4 &&
+        BigEndianUInt32(this->impl->_pending.data()) == 0) {
+      this->impl->_offset += 4;
+      this->impl->Clear();
+    } else {
+      err = Error(ErrorCode::InsufficientData,
+                  "Insufficient data available for read");
+    }
+  }
+
+  this->impl->_error = err;
+
+  return err;
+}
+
+void IncrementalParser::Reset() {
+  this->impl->_file = nullptr;
+  this->impl->_error = Error();
+  this->impl->_appended = 0;
+  this->impl->_offset = 0;
+  this->impl->Clear();
+}
+
+std::shared_ptr<File> IncrementalParser::GetFile() const {
+  return this->impl->_file;
+}
+
+Parser& IncrementalParser::GetParser() { return this->impl->_parser; }
+
+void IncrementalParser::SetBoxHandler(const BoxHandler& handler) {
+  this->impl->_handler = handler;
+}
+
+uint64_t IncrementalParser::GetBytesAppended() const {
+  return this->impl->_appended;
+}
+
+uint64_t IncrementalParser::GetPendingBytes() const {
+  return this->impl->_pending.size();
+}
+
+IncrementalParser::IMPL::IMPL() : _appended(0), _offset(0) { this->Clear(); }
+
+IncrementalParser::IMPL::IMPL(const Parser& parser)
+    : _parser(parser), _appended(0), _offset(0) {
+  this->Clear();
+}
+
+IncrementalParser::IMPL::IMPL(const IMPL& o)
+    : _parser(o._parser),
+      _file(o._file),
+      _handler(o._handler),
+      _error(o._error),
+      _appended(o._appended),
+      _offset(o._offset),
+      _received(o._received),
+      _pending(o._pending),
+      _hasHeader(o._hasHeader),
+      _name(o._name),
+      _headerSize(o._headerSize),
+      _size(o._size),
+      _toEnd(o._toEnd),
+      _skipped(o._skipped) {}
+
+IncrementalParser::IMPL::~IMPL() {}
+
+Error IncrementalParser::IMPL::Consume(const uint8_t* data, size_t size,
+                                       size_t& used) {
+  used = 0;
+
+  if (this->_hasHeader == false) {
+    if (this->_pending.empty() && size >= HeaderLength(data, size)) {
+      // the header is read in place, and consumed with the box
+      return this->ReadHeader(data);
+    }
+
+    size_t length = HeaderLength(this->_pending.data(), this->_pending.size());
+    used = std::min(size, length - this->_pending.size());
+
+    this->_pending.insert(this->_pending.end(), data, data + used);
+    this->_received = this->_pending.size();
+
+    if (this->_pending.size() < length ||
+        this->_pending.size() <
+            HeaderLength(this->_pending.data(), this->_pending.size())) {
+      return Error();
+    }
+
+    return this->ReadHeader(this->_pending.data());
+  }
+
+  if (this->_toEnd) {
+    used = size;
+  } else {
+    used = static_cast<size_t>(
+        std::min<uint64_t>(size, this->_size - this->_received));
+  }
+
+  // complete boxes are read in place
+  if (this->_received == 0 && used == this->_size &&
+      this->_skipped == nullptr) {
+    return this->Complete(data, used);
+  }
+
+  if (this->_skipped == nullptr) {
+    this->_pending.insert(this->_pending.end(), data, data + used);
+  }
+
+  this->_received += used;
+
+  if (this->_toEnd || this->_received < this->_size) {
+    return Error();
+  }
+
+  return this->Complete(this->_pending.data(), this->_received);
+}
+
+Error IncrementalParser::IMPL::ReadHeader(const uint8_t* header) {
+  Error err;
+
+  if (this->_offset == 0) {
+    BinaryDataStream stream(header, 8);
+
+    err = Parser::CheckFileHeader(stream);
+    if (err) return err;
+  }
+
+  this->_name.assign(reinterpret_cast<const char*>(header + 4), 4);
+  this->_size = BigEndianUInt32(header);
+  this->_headerSize = 8;
+  this->_toEnd = false;
+
+  if (this->_size == 1) {
+    this->_size = (static_cast<uint64_t>(BigEndianUInt32(header + 8)) << 32) |
+                  BigEndianUInt32(header + 12);
+    this->_headerSize = 16;
+  } else if (this->_size == 0) {
+    this->_toEnd = true;
+  }
+
+  if (this->_toEnd == false && this->_size < this->_headerSize) {
+    return Error(ErrorCode::InvalidBoxData, "Invalid box size");
+  }
+
+  this->_hasHeader = true;
+
+  // filtered boxes are kept, but are not read, like MDAT data
+  bool selected = this->_parser.IsBoxSelected(this->_name);
+
+  if (selected == false ||
+      (this->_name == "mdat" &&
+       !this->_parser.HasOption(Parser::Options::DoNotSkipMDATData)) ||
+      (this->_toEnd == false && this->_size - this->_headerSize >
+                                    (std::numeric_limits<size_t>::max)())) {
+    this->_skipped = (selected) ? this->_parser.CreateBox(this->_name)
+                                : std::make_shared<Box>(this->_name);
+    this->_pending.clear();
+  }
+
+  return Error();
+}
+
+Error IncrementalParser::IMPL::Complete(const uint8_t* data, uint64_t size) {
+  std::shared_ptr<Box> box = this->_skipped;
+
+  if (size < this->_headerSize) {
+    return Error(ErrorCode::InvalidBoxData, "Invalid box size");
+  }
+
+  // skipped boxes are created with their header, and have no data
+  if (box == nullptr) {
+    box = this->_parser.CreateBox(this->_name);
+  }
+
+  if (box != nullptr) {
+    box->SetOffset(this->_offset);
+    box->SetHeaderSize(this->_headerSize);
+    box->SetSize(size);
+
+    if (this->_skipped == nullptr) {
+      Error err = this->_parser.ReadBoxData(
+          box, data + this->_headerSize,
+          static_cast<size_t>(size - this->_headerSize));
+      if (err) return err;
+    }
+  }
+
+  if (this->_file == nullptr) {
+    this->_file = std::make_shared<File>();
+  }
+
+  this->_file->AddBox(box);
+  this->_offset += size;
+  this->Clear();
+
+  if (this->_handler != nullptr) {
+    this->_handler(box);
+  }
+
+  return Error();
+}
+
+void IncrementalParser::IMPL::Clear() {
+  this->_received = 0;
+  this->_pending.clear();
+  this->_hasHeader = false;
+  this->_name.clear();
+  this->_headerSize = 0;
+  this->_size = 0;
+  this->_toEnd = false;
+  this->_skipped = nullptr;
+}
+}  // namespace ISOBMFF
@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <MDHD.hpp>
 
 namespace ISOBMFF {
-class MDHD::IMPL {
+class MDHD::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
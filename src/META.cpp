@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
 #include <META.hpp>
+#include <Parser.hpp>
 #include <cstring>
 
 namespace ISOBMFF {
-class META::IMPL {
+class META::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -70,7 +71,6 @@ void swap(META& o1, META& o2) {
 
 Error META::ReadData(Parser& parser, BinaryStream& stream) {
   char n[4];
-  ContainerBox container("????");
   Error err;
 
   err = stream.Get(reinterpret_cast<uint8_t*>(n), 4, 4);
@@ -83,10 +83,10 @@ Error META::ReadData(Parser& parser, BinaryStream& stream) {
     if (err) return err;
   }
 
-  err = container.ReadData(parser, stream);
-  if (err) return err;
+  this->impl->_boxes.clear();
 
-  this->impl->_boxes = container.GetBoxes();
+  err = parser.ReadChildren(*(this), stream);
+  if (err) return err;
 
   return Error();
 }
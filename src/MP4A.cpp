@@ -28,11 +28,11 @@
  * @author      https://github.com/leela9980
  */
 
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
 #include <MP4A.hpp>
 
 namespace ISOBMFF {
-class MP4A::IMPL {
+class MP4A::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -72,7 +72,6 @@ void swap(MP4A& o1, MP4A& o2) {
 Error MP4A::ReadData(Parser& parser, BinaryStream& stream) {
   (void)parser;
   Error err;
-  ContainerBox container("????");
 
   // const unsigned int(8)[6] reserved = 0;
   uint8_t temp8;
@@ -126,8 +125,8 @@ Error MP4A::ReadData(Parser& parser, BinaryStream& stream) {
   SetSampleRateRaw(sampleRate);
 
   // stoping reading here
-  // container.ReadData( parser, stream );
-  this->impl->_boxes = container.GetBoxes();
+  // parser.ReadChildren( *( this ), stream );
+  this->impl->_boxes.clear();
   return Error();
 }
 
@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <MVHD.hpp>
 #include <cstring>
 
 namespace ISOBMFF {
-class MVHD::IMPL {
+class MVHD::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <PITM.hpp>
 
 namespace ISOBMFF {
-class PITM::IMPL {
+class PITM::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
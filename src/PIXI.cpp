@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <PIXI.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class PIXI::IMPL {
+class PIXI::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ParseContext.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ParseContext.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ISOBMFF {
+class ParseContext::IMPL {
+ public:
+  IMPL();
+  IMPL(const IMPL& o);
+  ~IMPL();
+
+  struct Entry {
+    const Box* box;
+    bool exposed;
+  };
+
+  std::vector<Entry> _boxes;
+  size_t _exposed;
+  std::map<std::string, void*> _info;
+  std::unique_ptr<Arena> _scratch;
+};
+
+ParseContext::ParseContext() : impl(std::make_unique<IMPL>()) {}
+
+ParseContext::ParseContext(const ParseContext& o)
+    : impl(std::make_unique<IMPL>(*(o.impl))) {}
+
+ParseContext::ParseContext(ParseContext&& o) noexcept
+    : impl(std::move(o.impl)) {
+  o.impl = nullptr;
+}
+
+ParseContext::~ParseContext() {}
+
+ParseContext& ParseContext::operator=(ParseContext o) {
+  swap(*(this), o);
+
+  return *(this);
+}
+
+void swap(ParseContext& o1, ParseContext& o2) {
+  using std::swap;
+
+  swap(o1.impl, o2.impl);
+}
+
+void ParseContext::PushBox(const Box& box) {
+  this->impl->_boxes.push_back({&box, false});
+}
+
+void ParseContext::PopBox() {
+  if (this->impl->_boxes.empty()) {
+    return;
+  }
+
+  if (this->impl->_boxes.back().exposed) {
+    this->impl->_exposed--;
+  }
+
+  this->impl->_boxes.pop_back();
+}
+
+size_t ParseContext::GetDepth() const { return this->impl->_boxes.size(); }
+
+const Box* ParseContext::GetBox(size_t level) const {
+  const std::vector<IMPL::Entry>& boxes = this->impl->_boxes;
+
+  if (level >= boxes.size()) {
+    return nullptr;
+  }
+
+  return boxes[boxes.size() - level - 1].box;
+}
+
+const Box* ParseContext::GetParent() const { return this->GetBox(1); }
+
+void ParseContext::ExposeBox() {
+  if (this->impl->_boxes.empty() || this->impl->_boxes.back().exposed) {
+    return;
+  }
+
+  this->impl->_boxes.back().exposed = true;
+  this->impl->_exposed++;
+}
+
+bool ParseContext::HasExposedBoxes() const { return this->impl->_exposed > 0; }
+
+const void* ParseContext::GetInfo(const std::string& key) const {
+  auto it = this->impl->_info.find(key);
+
+  if (it == this->impl->_info.end()) {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+void ParseContext::SetInfo(const std::string& key, void* value) {
+  if (value == nullptr) {
+    this->impl->_info.erase(key);
+  } else {
+    this->impl->_info[key] = value;
+  }
+}
+
+bool ParseContext::HasInfo() const {
+  return this->impl->_info.empty() == false;
+}
+
+Arena& ParseContext::GetScratch() {
+  if (this->impl->_scratch == nullptr) {
+    this->impl->_scratch = std::make_unique<Arena>();
+  }
+
+  return *(this->impl->_scratch);
+}
+
+void ParseContext::Reset() {
+  this->impl->_boxes.clear();
+  this->impl->_exposed = 0;
+  this->impl->_scratch = nullptr;
+}
+
+ParseContext::IMPL::IMPL() : _exposed(0) {}
+
+ParseContext::IMPL::IMPL(const IMPL& o)
+    : _boxes(o._boxes), _exposed(o._exposed), _info(o._info) {}
+
+ParseContext::IMPL::~IMPL() {}
+}  // namespace ISOBMFF
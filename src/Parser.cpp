@@ -32,9 +32,14 @@
 #include <AVC1.hpp>
 #include <AVC3.hpp>
 #include <AVCC.hpp>
+#include <Arena.hpp>
 #include <BinaryDataStream.hpp>
 #include <BinaryFileStream.hpp>
+#include <BinaryMappedFileStream.hpp>
+#include <BinarySubStream.hpp>
+#include <BoxVisitor.hpp>
 #include <CDSC.hpp>
+#include <CO64.hpp>
 #include <COLR.hpp>
 #include <CTTS.hpp>
 #include <ContainerBox.hpp>
@@ -62,18 +67,111 @@
 #include <PIXI.hpp>
 #include <Parser.hpp>
 #include <SCHM.hpp>
+#include <STCO.hpp>
+#include <STSC.hpp>
 #include <STSD.hpp>
 #include <STSS.hpp>
+#include <STSZ.hpp>
 #include <STTS.hpp>
+#include <STZ2.hpp>
 #include <THMB.hpp>
 #include <TKHD.hpp>
+#include <ThreadPool.hpp>
 #include <URL.hpp>
 #include <URN.hpp>
+#include <Utils.hpp>
 #include <cstring>
-#include <map>
+#include <iostream>
+#include <limits>
 #include <stdexcept>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace ISOBMFF {
+typedef std::function<std::shared_ptr<Box>()> BoxFactory;
+typedef std::unordered_map<uint32_t, BoxFactory> BoxRegistry;
+
+typedef std::shared_ptr<Box> (*DefaultBoxFactory)(
+    const std::string& type, const std::shared_ptr<Arena>& arena);
+typedef std::unordered_map<uint32_t, DefaultBoxFactory> DefaultBoxRegistry;
+typedef std::unordered_set<uint32_t> BoxTypeSet;
+
+/*
+ * Box paths are lists of FourCCs. In filters, a 0 type matches any box
+ * type, as FourCCs are made of printable characters.
+ */
+typedef std::vector<uint32_t> BoxPath;
+static constexpr uint32_t AnyBoxType = 0;
+
+/*
+ * Creates an object, from the arena if there is one. The arena is also
+ * made current while constructing, so the object's IMPLs come from it.
+ */
+template <typename T, typename... Args>
+static std::shared_ptr<T> MakeShared(const std::shared_ptr<Arena>& arena,
+                                     Args&&... args) {
+  if (arena == nullptr) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+
+  Arena::Scope scope(arena.get());
+
+  return std::allocate_shared<T>(Arena::Allocator<T>(arena.get()),
+                                 std::forward<Args>(args)...);
+}
+
+/*
+ * Box types known by default. The registry is built once, on first use,
+ * and is never modified afterwards, so all parsers share it. Parsers
+ * only keep their own registrations, which take precedence.
+ */
+class DefaultBoxes {
+ public:
+  static const DefaultBoxRegistry& GetRegistry();
+
+  // types whose children are boxes, right after the box header (or
+  // the full box header, for meta)
+  static const BoxTypeSet& GetContainers();
+
+ private:
+  DefaultBoxes();
+
+  static const DefaultBoxes& GetDefaults();
+
+  template <typename T>
+  static std::shared_ptr<Box> Create(const std::string& type,
+                                     const std::shared_ptr<Arena>& arena) {
+    (void)type;
+
+    return MakeShared<T>(arena);
+  }
+
+  static std::shared_ptr<Box> CreateContainer(
+      const std::string& type, const std::shared_ptr<Arena>& arena) {
+    return MakeShared<ContainerBox>(arena, type);
+  }
+
+  template <typename T>
+  void RegisterBox(const std::string& type) {
+    this->_types[Utils::FourCC(type)] = &DefaultBoxes::Create<T>;
+  }
+
+  template <typename T>
+  void RegisterContainerBox(const std::string& type) {
+    this->RegisterBox<T>(type);
+    this->_containers.insert(Utils::FourCC(type));
+  }
+
+  void RegisterContainerBox(const std::string& type) {
+    this->_types[Utils::FourCC(type)] = &DefaultBoxes::CreateContainer;
+    this->_containers.insert(Utils::FourCC(type));
+  }
+
+  DefaultBoxRegistry _types;
+  BoxTypeSet _containers;
+};
+
 class Parser::IMPL {
  public:
   IMPL();
@@ -83,16 +181,44 @@ class Parser::IMPL {
   Error RegisterBox(const std::string& type,
                     const std::function<std::shared_ptr<Box>()>& createBox);
   Error RegisterContainerBox(const std::string& type);
-  void RegisterDefaultBoxes();
+  bool IsContainerBox(uint32_t type) const;
+  bool HasBoxPaths() const;
+  Error Visit(Parser& parser, BinaryStream& stream, BoxVisitor& visitor);
 
   std::shared_ptr<File> _file;
   std::string _path;
-  std::map<std::string, std::function<std::shared_ptr<Box>()> > _types;
+  BoxRegistry _types;
+  BoxTypeSet _containers;
   Parser::StringType _stringType;
   uint64_t _options;
-  std::map<std::string, void*> _info;
+
+  // info values, and the boxes being read by copies made while parsing;
+  // each parse has its own context, starting with these values
+  ParseContext _context;
+  ParseContext* _current;
+
+  // box path filters, and the path of the box being read
+  std::vector<BoxPath> _allowedPaths;
+  std::vector<BoxPath> _deniedPaths;
+  BoxPath _boxPath;
+
+  // lazy decoding: the stream being parsed, and the parser used to read
+  // deferred boxes (a copy of this one, without the parsed file)
+  std::shared_ptr<BinaryStream> _stream;
+  std::shared_ptr<Parser> _loader;
+  std::weak_ptr<Parser> _self;
+
+  // arena allocation: the arena of the file being parsed
+  std::shared_ptr<Arena> _arena;
+
+  // parallel decoding: the pool reading sibling boxes
+  std::shared_ptr<ThreadPool> _pool;
+
+  size_t _maxDepth;
 };
 
+constexpr size_t Parser::DefaultMaxDepth;
+
 Parser::Parser() : impl(std::make_unique<IMPL>()) {}
 
 Parser::Parser(const std::string& path) : impl(std::make_unique<IMPL>()) {
@@ -104,6 +230,11 @@ Parser::Parser(const std::vector<uint8_t>& data)
   this->Parse(data);
 }
 
+Parser::Parser(const uint8_t* data, size_t size)
+    : impl(std::make_unique<IMPL>()) {
+  this->Parse(data, size);
+}
+
 Parser::Parser(BinaryStream& stream) : impl(std::make_unique<IMPL>()) {
   this->Parse(stream);
 }
@@ -138,20 +269,165 @@ Error Parser::RegisterBox(
   return this->impl->RegisterBox(type, createBox);
 }
 
+static Error ParseBoxPath(const std::string& path, BoxPath& types) {
+  size_t start = 0;
+
+  types.clear();
+
+  while (true) {
+    size_t end = path.find('/', start);
+    std::string type = path.substr(start, end - start);
+
+    if (type == "*") {
+      types.push_back(AnyBoxType);
+    } else if (type.size() == 4) {
+      types.push_back(Utils::FourCC(type));
+    } else {
+      return Error(ErrorCode::InvalidBoxData,
+                   "Box path components should be 4 characters long, or *");
+    }
+
+    if (end == std::string::npos) {
+      return Error();
+    }
+
+    start = end + 1;
+  }
+}
+
+Error Parser::AllowBoxPath(const std::string& path) {
+  BoxPath types;
+
+  Error err = ParseBoxPath(path, types);
+  if (err) return err;
+
+  this->impl->_allowedPaths.push_back(types);
+  return Error();
+}
+
+Error Parser::DenyBoxPath(const std::string& path) {
+  BoxPath types;
+
+  Error err = ParseBoxPath(path, types);
+  if (err) return err;
+
+  this->impl->_deniedPaths.push_back(types);
+  return Error();
+}
+
+void Parser::ClearBoxPaths() {
+  this->impl->_allowedPaths.clear();
+  this->impl->_deniedPaths.clear();
+}
+
+bool Parser::IsBoxSelected(const std::string& type) const {
+  if (this->impl->HasBoxPaths() == false) {
+    return true;
+  }
+
+  const BoxPath& path = this->impl->_boxPath;
+  uint32_t fourcc = Utils::FourCC(type);
+  size_t depth = path.size() + 1;
+
+  // the candidate box is the last component of its path
+  auto matches = [&](const BoxPath& pattern, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      uint32_t t = (i < path.size()) ? path[i] : fourcc;
+
+      if (pattern[i] != AnyBoxType && pattern[i] != t) {
+        return false;
+      }
+    }
+
+    return true;
+  };
+
+  for (const auto& pattern : this->impl->_deniedPaths) {
+    if (pattern.size() <= depth && matches(pattern, pattern.size())) {
+      return false;
+    }
+  }
+
+  if (this->impl->_allowedPaths.empty()) {
+    return true;
+  }
+
+  // allowed boxes, their children, and the boxes leading to them
+  for (const auto& pattern : this->impl->_allowedPaths) {
+    if (matches(pattern, std::min(pattern.size(), depth))) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void Parser::EnterBox(const std::string& type) {
+  this->impl->_boxPath.push_back(Utils::FourCC(type));
+}
+
+void Parser::LeaveBox() {
+  if (this->impl->_boxPath.empty() == false) {
+    this->impl->_boxPath.pop_back();
+  }
+}
+
 std::shared_ptr<Box> Parser::CreateBox(const std::string& type) const {
-  for (const auto& p : this->impl->_types) {
-    if (p.first == type && p.second != nullptr) {
-      return p.second();
+  if (type.size() != 4) {
+    return std::make_shared<Box>(type);
+  }
+
+  uint32_t fourcc = Utils::FourCC(type);
+
+  if (this->impl->_types.empty() == false) {
+    auto it = this->impl->_types.find(fourcc);
+
+    // a null registration hides the default type
+    if (it != this->impl->_types.end()) {
+      return (it->second != nullptr) ? it->second()
+                                     : std::make_shared<Box>(type);
     }
   }
 
+  const DefaultBoxRegistry& defaults = DefaultBoxes::GetRegistry();
+  auto it = defaults.find(fourcc);
+
+  if (it != defaults.end()) {
+    return it->second(type, this->impl->_arena);
+  }
+
   return std::make_shared<Box>(type);
 }
 
 Error Parser::Parse(const std::string& path) {
-  BinaryFileStream stream(path);
+  Error err;
+
+  /*
+   * Streams are shared, so boxes whose decoding is deferred keep the
+   * file open for as long as they need it.
+   */
+  if (this->HasOption(Options::DoNotMapFiles) == false) {
+    std::shared_ptr<BinaryMappedFileStream> mapped =
+        std::make_shared<BinaryMappedFileStream>(path);
+
+    if (mapped->IsMapped()) {
+      this->impl->_stream = mapped;
+      err = this->Parse(*(mapped));
+      this->impl->_stream = nullptr;
+      if (err) return err;
+
+      this->impl->_path = path;
 
-  Error err = this->Parse(stream);
+      return Error();
+    }
+  }
+
+  std::shared_ptr<BinaryFileStream> stream =
+      std::make_shared<BinaryFileStream>(path);
+
+  this->impl->_stream = stream;
+  err = this->Parse(*(stream));
+  this->impl->_stream = nullptr;
   if (err) return err;
 
   this->impl->_path = path;
@@ -160,12 +436,39 @@ Error Parser::Parse(const std::string& path) {
 }
 
 Error Parser::Parse(const std::vector<uint8_t>& data) {
-  BinaryDataStream stream(data);
+  if (this->HasOption(Options::LazyDecoding) == false) {
+    return this->Parse(data.data(), data.size());
+  }
+
+  // deferred boxes may outlive the caller's vector, so they get a copy
+  std::shared_ptr<BinaryDataStream> stream =
+      std::make_shared<BinaryDataStream>(data);
+
+  this->impl->_stream = stream;
+  Error err = this->Parse(*(stream));
+  this->impl->_stream = nullptr;
 
-  return this->Parse(stream);
+  return err;
 }
 
-Error Parser::Parse(BinaryStream& stream) {
+Error Parser::Parse(const uint8_t* data, size_t size) {
+  std::shared_ptr<BinaryDataStream> stream =
+      std::make_shared<BinaryDataStream>(data, size);
+
+  this->impl->_stream = stream;
+  Error err = this->Parse(*(stream));
+  this->impl->_stream = nullptr;
+
+  return err;
+}
+
+static uint32_t BigEndianUInt32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) |
+         (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+Error Parser::CheckFileHeader(BinaryStream& stream) {
   char n[4] = {0, 0, 0, 0};
 
   if (stream.HasBytesAvailable() == false) {
@@ -184,17 +487,271 @@ Error Parser::Parse(BinaryStream& stream) {
     return Error(ErrorCode::NotISOMediaFile, "Data is not an ISO media file");
   }
 
+  return Error();
+}
+
+Error Parser::Parse(BinaryStream& stream) {
+  Error err = CheckFileHeader(stream);
+  if (err) return err;
+
+  ParseContext context(this->impl->_context);
+
   this->impl->_path = "";
-  this->impl->_file = std::make_shared<File>();
+  this->impl->_loader = nullptr;
+  this->impl->_arena = nullptr;
+  this->impl->_boxPath.clear();
+  this->impl->_current = &(context);
+
+  if (this->HasOption(Options::ArenaAllocation)) {
+    this->impl->_arena = Arena::Create();
+  }
+
+  this->impl->_file = MakeShared<File>(this->impl->_arena);
+
+  if (this->impl->_stream.get() != &stream) {
+    // caller-owned stream: deferred boxes only borrow it
+    this->impl->_stream =
+        std::shared_ptr<BinaryStream>(&stream, [](BinaryStream*) {});
+  }
 
   if (stream.HasBytesAvailable()) {
     err = this->impl->_file->ReadData(*(this), stream);
+  }
+
+  // boxes keep the stream, the loader and the arena alive as needed
+  this->impl->_stream = nullptr;
+  this->impl->_loader = nullptr;
+  this->impl->_arena = nullptr;
+  this->impl->_current = nullptr;
+
+  return err;
+}
+
+/*
+ * A box header. Terminators are the 32-bit zeros QuickTime allows at
+ * the end of containers: they are 4 bytes long, and have no type.
+ */
+struct BoxHeader {
+  std::string name;
+  uint32_t type;
+  uint64_t headerSize;
+  uint64_t size;
+  bool terminator;
+};
+
+/*
+ * Reads the header of a box found at a position, in place, with the
+ * given number of bytes left in its parent. A size of 0, meaning the
+ * end of the parent, is resolved.
+ */
+static Error ReadBoxHeader(BinaryStream& stream, uint64_t pos,
+                           uint64_t available, BoxHeader& header) {
+  uint8_t bytes[16];
+
+  Error err = stream.ReadAt(
+      pos, bytes,
+      static_cast<size_t>(std::min<uint64_t>(available, sizeof(bytes))));
+  if (err) return err;
+
+  header.terminator = false;
+
+  if (available < 8) {
+    if (available == 4 && BigEndianUInt32(bytes) == 0) {
+      header.terminator = true;
+      header.size = 4;
+      return Error();
+    }
+
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  header.size = BigEndianUInt32(bytes);
+  header.headerSize = 8;
+
+  if (header.size == 1) {
+    if (available < 16) {
+      return Error(ErrorCode::InsufficientData,
+                   "Insufficient data available for read");
+    }
+
+    header.size = (static_cast<uint64_t>(BigEndianUInt32(bytes + 8)) << 32) |
+                  BigEndianUInt32(bytes + 12);
+    header.headerSize = 16;
+  } else if (header.size == 0) {
+    header.size = available;
+  }
+
+  if (header.size < header.headerSize) {
+    return Error(ErrorCode::InvalidBoxData, "Invalid box size");
+  }
+
+  if (header.size > available) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  header.name.assign(reinterpret_cast<const char*>(bytes + 4), 4);
+  header.type = BigEndianUInt32(bytes + 4);
+
+  return Error();
+}
+
+/*
+ * Finds where the children of a container box start. meta is a full
+ * box, except in QuickTime files.
+ */
+static Error GetChildrenOffset(BinaryStream& stream, uint64_t pos,
+                               const BoxHeader& header, uint64_t& start) {
+  start = pos + header.headerSize;
+
+  if (header.name != "meta") {
+    return Error();
+  }
+
+  uint8_t next[4];
+
+  if (header.size - header.headerSize < 8) {
+    // too small for children
+    start = pos + header.size;
+    return Error();
+  }
+
+  Error err = stream.ReadAt(start + 4, next, 4);
+  if (err) return err;
+
+  if (memcmp(next, "hdlr", 4) != 0) {
+    start += 4;
+  }
+
+  return Error();
+}
+
+Error Parser::Scan(const std::string& path,
+                   std::vector<BoxMapEntry>& boxes) const {
+  if ((this->impl->_options &
+       static_cast<uint64_t>(Options::DoNotMapFiles)) == 0) {
+    BinaryMappedFileStream mapped(path);
+
+    if (mapped.IsMapped()) {
+      return this->Scan(mapped, boxes);
+    }
+  }
+
+  BinaryFileStream stream(path);
+
+  return this->Scan(stream, boxes);
+}
+
+Error Parser::Scan(const uint8_t* data, size_t size,
+                   std::vector<BoxMapEntry>& boxes) const {
+  BinaryDataStream stream(data, size);
+
+  return this->Scan(stream, boxes);
+}
+
+Error Parser::Scan(BinaryStream& stream,
+                   std::vector<BoxMapEntry>& boxes) const {
+  struct Level {
+    uint64_t end;
+    size_t pathLength;
+  };
+
+  boxes.clear();
+
+  Error err = CheckFileHeader(stream);
+  if (err) return err;
+
+  // windows are flattened, so this is the offset in the file
+  BinarySubStream* sub = dynamic_cast<BinarySubStream*>(&stream);
+  uint64_t base = (sub != nullptr) ? sub->GetOffset() : 0;
+  uint64_t pos = stream.Tell();
+  std::vector<Level> levels = {{stream.Size(), 0}};
+  std::string path;
+  BoxHeader header;
+
+  // headers are read in place, so the stream position is left unchanged
+  while (true) {
+    uint64_t available = levels.back().end - pos;
+
+    if (available == 0) {
+      if (levels.size() == 1) {
+        break;
+      }
+
+      path.resize(levels.back().pathLength);
+      pos = levels.back().end;
+      levels.pop_back();
+      continue;
+    }
+
+    err = ReadBoxHeader(stream, pos, available, header);
     if (err) return err;
+
+    if (header.terminator) {
+      pos += header.size;
+      continue;
+    }
+
+    boxes.push_back({path + header.name, header.type, base + pos,
+                     header.headerSize, header.size});
+
+    if (this->impl->IsContainerBox(header.type) == false) {
+      pos += header.size;
+      continue;
+    }
+
+    uint64_t start;
+
+    err = GetChildrenOffset(stream, pos, header, start);
+    if (err) return err;
+
+    levels.push_back({pos + header.size, path.size()});
+    path += header.name + "/";
+    pos = start;
   }
 
   return Error();
 }
 
+Error Parser::Parse(const std::string& path, BoxVisitor& visitor) {
+  if (this->HasOption(Options::DoNotMapFiles) == false) {
+    BinaryMappedFileStream mapped(path);
+
+    if (mapped.IsMapped()) {
+      return this->Parse(mapped, visitor);
+    }
+  }
+
+  BinaryFileStream stream(path);
+
+  return this->Parse(stream, visitor);
+}
+
+Error Parser::Parse(const uint8_t* data, size_t size, BoxVisitor& visitor) {
+  BinaryDataStream stream(data, size);
+
+  return this->Parse(stream, visitor);
+}
+
+Error Parser::Parse(BinaryStream& stream, BoxVisitor& visitor) {
+  Error err = CheckFileHeader(stream);
+  if (err) return err;
+
+  // nothing is deferred, as boxes are not kept
+  std::shared_ptr<BinaryStream> previous = std::move(this->impl->_stream);
+  ParseContext context(this->impl->_context);
+
+  this->impl->_boxPath.clear();
+  this->impl->_current = &(context);
+  err = this->impl->Visit(*(this), stream, visitor);
+  this->impl->_current = nullptr;
+  this->impl->_boxPath.clear();
+  this->impl->_stream = std::move(previous);
+
+  return err;
+}
+
 std::shared_ptr<File> Parser::GetFile() const { return this->impl->_file; }
 
 Parser::StringType Parser::GetPreferredStringType() const {
@@ -221,36 +778,501 @@ bool Parser::HasOption(Options option) {
   return (this->GetOptions() & static_cast<uint64_t>(option)) != 0;
 }
 
+std::shared_ptr<ThreadPool> Parser::GetThreadPool() const {
+  return this->impl->_pool;
+}
+
+void Parser::SetThreadPool(const std::shared_ptr<ThreadPool>& pool) {
+  this->impl->_pool = pool;
+}
+
+size_t Parser::GetMaxDepth() const { return this->impl->_maxDepth; }
+
+void Parser::SetMaxDepth(size_t value) { this->impl->_maxDepth = value; }
+
+ParseContext& Parser::GetContext() {
+  return (this->impl->_current != nullptr) ? *(this->impl->_current)
+                                           : this->impl->_context;
+}
+
 const void* Parser::GetInfo(const std::string& key) {
-  if (this->impl->_info.find(key) == this->impl->_info.end()) {
-    return nullptr;
+  return this->GetContext().GetInfo(key);
+}
+
+void Parser::SetInfo(const std::string& key, void* value) {
+  // values set while parsing are also kept for the next parses
+  this->impl->_context.SetInfo(key, value);
+
+  if (this->impl->_current != nullptr) {
+    this->impl->_current->SetInfo(key, value);
+  }
+}
+
+bool Parser::DeferBox(const std::shared_ptr<Box>& box, BinaryStream& stream,
+                      size_t length) {
+  if (this->HasOption(Options::LazyDecoding) == false || box == nullptr ||
+      this->impl->_stream == nullptr ||
+      this->GetContext().HasExposedBoxes() ||
+      this->GetContext().HasInfo() ||
+      dynamic_cast<ContainerBox*>(box.get()) != nullptr) {
+    return false;
+  }
+
+  BinarySubStream* sub = dynamic_cast<BinarySubStream*>(&stream);
+  BinaryStream& source = (sub != nullptr) ? sub->GetSource() : stream;
+  size_t offset = ((sub != nullptr) ? sub->GetOffset() : 0) + stream.Tell();
+
+  if (&source != this->impl->_stream.get()) {
+    return false;
+  }
+
+  std::shared_ptr<Parser> loader = this->impl->_self.lock();
+
+  if (loader == nullptr) {
+    if (this->impl->_loader == nullptr) {
+      this->impl->_loader = std::make_shared<Parser>(*(this));
+      this->impl->_loader->impl->_file = nullptr;
+      this->impl->_loader->impl->_loader = nullptr;
+      this->impl->_loader->impl->_context.Reset();
+      this->impl->_loader->impl->_self = this->impl->_loader;
+    }
+
+    loader = this->impl->_loader;
   }
 
-  return this->impl->_info[key];
+  std::shared_ptr<BinaryStream> root = this->impl->_stream;
+
+  // filters depend on the path, which is restored while loading
+  BoxPath path;
+  if (this->impl->HasBoxPaths()) {
+    path = this->impl->_boxPath;
+  }
+
+  box->Defer([loader, root, offset, length, path](Box& b) -> Error {
+    BinarySubStream content(*(root), offset, length);
+    ParseContext context(loader->impl->_context);
+
+    // each load is a parse of its own
+    loader->impl->_current = &(context);
+
+    if (path.empty()) {
+      context.PushBox(b);
+      Error err = b.ReadData(*(loader), content);
+      context.PopBox();
+      loader->impl->_current = nullptr;
+
+      return err;
+    }
+
+    BoxPath previous = std::move(loader->impl->_boxPath);
+    loader->impl->_boxPath = path;
+    context.PushBox(b);
+    Error err = b.ReadData(*(loader), content);
+    context.PopBox();
+    loader->impl->_boxPath = std::move(previous);
+    loader->impl->_current = nullptr;
+
+    return err;
+  });
+
+  return true;
 }
 
-void Parser::SetInfo(const std::string& key, void* value) {
-  if (value == nullptr) {
-    this->impl->_info.erase(key);
+/*
+ * Boxes read from a copy of their data find their children at offsets
+ * relative to the copy, which are made relative to the file.
+ */
+static void ShiftOffsets(const std::shared_ptr<Box>& box, uint64_t delta) {
+  Container* container = dynamic_cast<Container*>(box.get());
+
+  if (container == nullptr || delta == 0) {
+    return;
+  }
+
+  for (const auto& child : container->GetBoxes()) {
+    if (child != nullptr) {
+      child->SetOffset(child->GetOffset() + delta);
+      ShiftOffsets(child, delta);
+    }
+  }
+}
+
+Error Parser::ReadBoxData(const std::shared_ptr<Box>& box,
+                          const uint8_t* data, size_t size) {
+  BinaryDataStream stream(data, size);
+
+  this->EnterBox(box->GetName());
+  this->GetContext().PushBox(*(box));
+  Error err = box->ReadData(*(this), stream);
+  this->GetContext().PopBox();
+  this->LeaveBox();
+  if (err) return err;
+
+  ShiftOffsets(box, box->GetOffset() + box->GetHeaderSize());
+
+  return Error();
+}
+
+/*
+ * Reads the data of boxes through the cursor of a stream, which is
+ * restored afterwards, for streams not supporting concurrent
+ * positional reads.
+ */
+static Error ReadPayloads(BinaryStream& stream,
+                          const std::vector<std::shared_ptr<Box> >& boxes,
+                          const std::vector<uint8_t*>& payloads) {
+  size_t cur(stream.Tell());
+  std::streamoff pos;
+  Error err;
+
+  for (size_t i = 0; i < boxes.size() && !err; i++) {
+    const std::shared_ptr<Box>& box = boxes[i];
+
+    err = numeric_cast<std::streamoff>(
+        pos, box->GetOffset() + box->GetHeaderSize());
+    if (!err) {
+      err = stream.Seek(pos, BinaryStream::SeekDirection::Begin);
+    }
+    if (!err) {
+      err = stream.Read(
+          payloads[i],
+          static_cast<size_t>(box->GetSize() - box->GetHeaderSize()));
+    }
+  }
+
+  if (!numeric_cast<std::streamoff>(pos, cur)) {
+    stream.Seek(pos, BinaryStream::SeekDirection::Begin);
+  }
+
+  return err;
+}
+
+Error Parser::ReadBoxes(const std::vector<std::shared_ptr<Box> >& boxes,
+                        BinaryStream& stream) {
+  BinarySubStream* sub = dynamic_cast<BinarySubStream*>(&stream);
+  BinaryStream& source = (sub != nullptr) ? sub->GetSource() : stream;
+  std::vector<Error> errors(boxes.size());
+  ThreadPool* pool = nullptr;
+
+  // the boxes are one level below the boxes being read, and workers
+  // count from there, as their context is a copy of this one
+  if (boxes.empty() == false &&
+      this->GetContext().GetDepth() >= this->impl->_maxDepth) {
+    return Error(ErrorCode::InvalidBoxData, "Boxes are nested too deeply");
+  }
+
+  if (this->HasOption(Options::ParallelDecoding) && boxes.size() > 1) {
+    pool = (this->impl->_pool != nullptr) ? this->impl->_pool.get()
+                                          : &(ThreadPool::GetDefault());
+  }
+
+  if (pool == nullptr || pool->GetThreadCount() < 2) {
+    for (size_t i = 0; i < boxes.size(); i++) {
+      const std::shared_ptr<Box>& box = boxes[i];
+      BinarySubStream content(
+          source, static_cast<size_t>(box->GetOffset() + box->GetHeaderSize()),
+          static_cast<size_t>(box->GetSize() - box->GetHeaderSize()));
+
+      this->EnterBox(box->GetName());
+      this->GetContext().PushBox(*(box));
+      errors[i] = box->ReadData(*(this), content);
+      this->GetContext().PopBox();
+      this->LeaveBox();
+      if (errors[i]) break;
+    }
   } else {
-    this->impl->_info[key] = value;
+    std::vector<ThreadPool::Task> tasks;
+    std::vector<uint8_t*> payloads(boxes.size(), nullptr);
+    const uint8_t* bytes = source.GetBytes();
+
+    // sources held in memory are parsed in place, and the data of other
+    // boxes goes to scratch memory, reserved here as arenas are not
+    // shared between threads
+    if (bytes == nullptr) {
+      Arena& scratch = this->GetContext().GetScratch();
+
+      for (size_t i = 0; i < boxes.size(); i++) {
+        payloads[i] = static_cast<uint8_t*>(scratch.Allocate(
+            static_cast<size_t>(boxes[i]->GetSize() -
+                                boxes[i]->GetHeaderSize()),
+            1));
+      }
+    }
+
+    // streams whose positional reads use the cursor are read here, on
+    // the calling thread, so the workers only parse
+    if (bytes == nullptr && source.IsReadAtThreadSafe() == false) {
+      Error err = ReadPayloads(source, boxes, payloads);
+      if (err) return err;
+    }
+
+    for (size_t i = 0; i < boxes.size(); i++) {
+      tasks.push_back([this, &boxes, &source, &errors, &payloads, bytes, i]() {
+        const std::shared_ptr<Box>& box = boxes[i];
+        const uint64_t offset = box->GetOffset() + box->GetHeaderSize();
+        const size_t size =
+            static_cast<size_t>(box->GetSize() - box->GetHeaderSize());
+        const uint8_t* data;
+
+        // workers have their own state and arena, and a copy of the
+        // context, whose boxes outlive them
+        Parser worker(*(this));
+        worker.impl->_file = nullptr;
+        worker.impl->_stream = nullptr;
+        worker.impl->_loader = nullptr;
+        worker.impl->_arena =
+            (this->impl->_arena != nullptr) ? Arena::Create() : nullptr;
+        worker.RemoveOption(Options::ParallelDecoding);
+
+        if (bytes != nullptr) {
+          data = bytes + static_cast<size_t>(offset);
+        } else {
+          if (source.IsReadAtThreadSafe()) {
+            errors[i] = source.ReadAt(offset, payloads[i], size);
+            if (errors[i]) return;
+          }
+
+          data = payloads[i];
+        }
+
+        errors[i] = worker.ReadBoxData(box, data, size);
+      });
+    }
+
+    pool->Run(tasks);
+  }
+
+  for (size_t i = 0; i < boxes.size(); i++) {
+    if (errors[i]) {
+      std::cerr << "Error while reading box " << boxes[i]->GetName() << ": "
+                << errors[i].GetMessage() << std::endl;
+      return errors[i];
+    }
   }
+
+  return Error();
 }
 
-Parser::IMPL::IMPL()
-    : _stringType(Parser::StringType::NULLTerminated), _options(0) {
-  this->RegisterDefaultBoxes();
+Error Parser::ReadChildren(Container& container, BinaryStream& stream) {
+  /*
+   * A container whose boxes are being read. Plain containers found
+   * while reading are added as levels, read through a window over
+   * their data, instead of through a recursive call. Other boxes
+   * having children call this method from their ReadData.
+   */
+  struct Level {
+    Container* container;
+    std::shared_ptr<Box> box;
+    std::unique_ptr<BinarySubStream> window;
+    uint64_t base;
+    size_t end;
+    bool done;
+    std::vector<std::shared_ptr<Box> > pending;
+  };
+
+  ParseContext& context = this->GetContext();
+  std::vector<Level> levels;
+  Error err;
+
+  // with ParallelDecoding, boxes having children are read at the end
+  bool parallel = this->HasOption(Options::ParallelDecoding);
+
+  // windows are flattened, so this is the offset in the file
+  BinarySubStream* sub = dynamic_cast<BinarySubStream*>(&stream);
+  uint64_t base = (sub != nullptr) ? sub->GetOffset() : 0;
+
+  levels.push_back({&container, nullptr, nullptr, base, 0, false, {}});
+
+  // errors are reported for each level, like nested calls would
+  auto unwind = [&](const Error& e) -> Error {
+    while (levels.size() > 1) {
+      std::cerr << "Error while reading box " << levels.back().box->GetName()
+                << ": " << e.GetMessage() << std::endl;
+      context.PopBox();
+      this->LeaveBox();
+      levels.pop_back();
+    }
+
+    return e;
+  };
+
+  while (true) {
+    Level& level = levels.back();
+    BinaryStream& current =
+        (level.window != nullptr) ? *(level.window) : stream;
+
+    if (level.done == false && current.HasBytesAvailable()) {
+      uint64_t offset = level.base + current.Tell();
+      uint64_t length;
+      uint64_t headerSize;
+      uint32_t temp32;
+      std::string name;
+      std::shared_ptr<Box> box;
+
+      err = current.ReadBigEndianUInt32(temp32);
+      if (err) return unwind(err);
+      length = temp32;
+
+      if (length == 0 && !current.HasBytesAvailable()) {
+        level.done = true;
+        continue;
+      }
+
+      err = current.ReadFourCC(name);
+      if (err) return unwind(err);
+
+      headerSize = 8;
+
+      if (length == 1) {
+        err = current.ReadBigEndianUInt64(length);
+        if (err) return unwind(err);
+
+        headerSize = 16;
+      }
+
+      if (length < headerSize) {
+        return unwind(Error(ErrorCode::InvalidBoxData, "Invalid box size"));
+      }
+
+      // filtered boxes are kept in the tree, but are not read
+      bool selected = this->IsBoxSelected(name);
+      box = (selected) ? this->CreateBox(name) : std::make_shared<Box>(name);
+
+      if (box != nullptr) {
+        box->SetOffset(offset);
+        box->SetHeaderSize(headerSize);
+        box->SetSize(length);
+      }
+
+      if (selected == false ||
+          length - headerSize > (std::numeric_limits<size_t>::max)() ||
+          (name == "mdat" && !this->HasOption(Options::DoNotSkipMDATData))) {
+        err = current.Seek(length - headerSize,
+                           BinaryStream::SeekDirection::Current);
+        if (err) return unwind(err);
+      } else if (parallel && dynamic_cast<Container*>(box.get()) != nullptr) {
+        if (length - headerSize > current.AvailableBytes()) {
+          return unwind(Error(ErrorCode::InsufficientData,
+                              "Insufficient data available for read"));
+        }
+
+        if (context.GetDepth() >= this->impl->_maxDepth) {
+          return unwind(Error(ErrorCode::InvalidBoxData,
+                              "Boxes are nested too deeply"));
+        }
+
+        level.pending.push_back(box);
+
+        err = current.Seek(length - headerSize,
+                           BinaryStream::SeekDirection::Current);
+        if (err) return unwind(err);
+      } else {
+        size_t start = current.Tell();
+        size_t dataLength = static_cast<size_t>(length - headerSize);
+
+        if (dataLength > current.AvailableBytes()) {
+          return unwind(Error(ErrorCode::InsufficientData,
+                              "Insufficient data available for read"));
+        }
+
+        if (context.GetDepth() >= this->impl->_maxDepth) {
+          return unwind(Error(ErrorCode::InvalidBoxData,
+                              "Boxes are nested too deeply"));
+        }
+
+        this->EnterBox(name);
+
+        if (box != nullptr && typeid(*(box)) == typeid(ContainerBox)) {
+          std::unique_ptr<BinarySubStream> window =
+              std::make_unique<BinarySubStream>(current, start, dataLength);
+          uint64_t windowBase = window->GetOffset();
+
+          context.PushBox(*(box));
+          levels.push_back({static_cast<ContainerBox*>(box.get()), box,
+                            std::move(window), windowBase, start + dataLength,
+                            false, {}});
+          continue;
+        }
+
+        if (box != nullptr &&
+            this->DeferBox(box, current, dataLength) == false) {
+          // children read their payload in place, through a window
+          BinarySubStream content(current, start, dataLength);
+
+          context.PushBox(*(box));
+          Error boxErr = box->ReadData(*(this), content);
+          context.PopBox();
+          if (boxErr) {
+            this->LeaveBox();
+            std::cerr << "Error while reading box " << name << ": "
+                      << boxErr.GetMessage() << std::endl;
+            return unwind(boxErr);
+          }
+        }
+
+        this->LeaveBox();
+
+        err = current.Seek(start + dataLength,
+                           BinaryStream::SeekDirection::Begin);
+        if (err) return unwind(err);
+      }
+
+      level.container->AddBox(box);
+      continue;
+    }
+
+    // all the boxes of this level are known
+    if (level.pending.empty() == false) {
+      err = this->ReadBoxes(level.pending, current);
+      if (err) return unwind(err);
+    }
+
+    if (levels.size() == 1) {
+      break;
+    }
+
+    Level done = std::move(levels.back());
+
+    levels.pop_back();
+    context.PopBox();
+    this->LeaveBox();
+
+    Level& parent = levels.back();
+    BinaryStream& outer =
+        (parent.window != nullptr) ? *(parent.window) : stream;
+
+    err = outer.Seek(done.end, BinaryStream::SeekDirection::Begin);
+    if (err) return unwind(err);
+
+    parent.container->AddBox(done.box);
+  }
+
+  return Error();
 }
 
+Parser::IMPL::IMPL()
+    : _stringType(Parser::StringType::NULLTerminated),
+      _options(0),
+      _current(nullptr),
+      _maxDepth(Parser::DefaultMaxDepth) {}
+
 Parser::IMPL::IMPL(const IMPL& o)
     : _file(o._file),
       _path(o._path),
       _types(o._types),
+      _containers(o._containers),
       _stringType(o._stringType),
       _options(o._options),
-      _info(o._info) {
-  this->RegisterDefaultBoxes();
-}
+      _context((o._current != nullptr) ? *(o._current) : o._context),
+      _current(nullptr),
+      _allowedPaths(o._allowedPaths),
+      _deniedPaths(o._deniedPaths),
+      _boxPath(o._boxPath),
+      _stream(o._stream),
+      _loader(o._loader),
+      _arena(o._arena),
+      _pool(o._pool),
+      _maxDepth(o._maxDepth) {}
 
 Parser::IMPL::~IMPL() {}
 
@@ -262,17 +1284,175 @@ Error Parser::IMPL::RegisterBox(
                  "Box name should be 4 characters long");
   }
 
-  this->_types[type] = createBox;
+  this->_types[Utils::FourCC(type)] = createBox;
+  this->_containers.erase(Utils::FourCC(type));
   return Error();
 }
 
 Error Parser::IMPL::RegisterContainerBox(const std::string& type) {
-  return this->RegisterBox(type, [=]() -> std::shared_ptr<Box> {
+  Error err = this->RegisterBox(type, [=]() -> std::shared_ptr<Box> {
     return std::make_shared<ContainerBox>(type);
   });
+  if (err) return err;
+
+  this->_containers.insert(Utils::FourCC(type));
+  return Error();
+}
+
+bool Parser::IMPL::HasBoxPaths() const {
+  return this->_allowedPaths.empty() == false ||
+         this->_deniedPaths.empty() == false;
 }
 
-void Parser::IMPL::RegisterDefaultBoxes() {
+bool Parser::IMPL::IsContainerBox(uint32_t type) const {
+  if (this->_types.find(type) != this->_types.end()) {
+    return this->_containers.count(type) > 0;
+  }
+
+  return DefaultBoxes::GetContainers().count(type) > 0;
+}
+
+Error Parser::IMPL::Visit(Parser& parser, BinaryStream& stream,
+                          BoxVisitor& visitor) {
+  struct Level {
+    uint64_t end;
+    size_t pathLength;
+    Parser::BoxMapEntry entry;
+  };
+
+  typedef BoxVisitor::Action Action;
+
+  // windows are flattened, so this is the offset in the file
+  BinarySubStream* sub = dynamic_cast<BinarySubStream*>(&stream);
+  uint64_t base = (sub != nullptr) ? sub->GetOffset() : 0;
+  uint64_t pos = stream.Tell();
+  std::vector<Level> levels;
+  std::string path;
+  BoxHeader header;
+  Error err;
+
+  levels.push_back({stream.Size(), 0, {}});
+
+  // like Scan, boxes are read in place, and the stream does not move
+  while (true) {
+    uint64_t available = levels.back().end - pos;
+
+    if (available == 0) {
+      if (levels.size() == 1) {
+        break;
+      }
+
+      Level level = std::move(levels.back());
+
+      levels.pop_back();
+      path.resize(level.pathLength);
+      pos = level.end;
+      parser.LeaveBox();
+
+      if (visitor.ExitBox(level.entry) == Action::Stop) {
+        break;
+      }
+
+      continue;
+    }
+
+    err = ReadBoxHeader(stream, pos, available, header);
+    if (err) return err;
+
+    if (header.terminator) {
+      pos += header.size;
+      continue;
+    }
+
+    // filtered boxes are not visited at all
+    if (parser.IsBoxSelected(header.name) == false) {
+      pos += header.size;
+      continue;
+    }
+
+    Parser::BoxMapEntry entry = {path + header.name, header.type, base + pos,
+                                 header.headerSize, header.size};
+    Action action = visitor.EnterBox(entry);
+
+    if (action == Action::Stop) {
+      break;
+    } else if (action == Action::Skip) {
+      pos += header.size;
+      continue;
+    }
+
+    if (this->IsContainerBox(header.type)) {
+      uint64_t start;
+
+      if (levels.size() > this->_maxDepth) {
+        return Error(ErrorCode::InvalidBoxData, "Boxes are nested too deeply");
+      }
+
+      err = GetChildrenOffset(stream, pos, header, start);
+      if (err) return err;
+
+      levels.push_back({pos + header.size, path.size(), std::move(entry)});
+      path += header.name + "/";
+      parser.EnterBox(header.name);
+      pos = start;
+      continue;
+    }
+
+    std::shared_ptr<Box> box = parser.CreateBox(header.name);
+    uint64_t length = header.size - header.headerSize;
+
+    if (box != nullptr) {
+      box->SetOffset(entry.offset);
+      box->SetHeaderSize(header.headerSize);
+      box->SetSize(header.size);
+
+      if (length <= (std::numeric_limits<size_t>::max)() &&
+          (header.name != "mdat" ||
+           parser.HasOption(Parser::Options::DoNotSkipMDATData))) {
+        BinarySubStream content(stream,
+                                static_cast<size_t>(pos + header.headerSize),
+                                static_cast<size_t>(length));
+
+        parser.EnterBox(header.name);
+        parser.GetContext().PushBox(*(box));
+        err = box->ReadData(parser, content);
+        parser.GetContext().PopBox();
+        parser.LeaveBox();
+        if (err) return err;
+      }
+
+      if (visitor.VisitBox(box) == Action::Stop) {
+        break;
+      }
+
+      box = nullptr;
+    }
+
+    if (visitor.ExitBox(entry) == Action::Stop) {
+      break;
+    }
+
+    pos += header.size;
+  }
+
+  return Error();
+}
+
+const DefaultBoxes& DefaultBoxes::GetDefaults() {
+  static const DefaultBoxes defaults;
+
+  return defaults;
+}
+
+const DefaultBoxRegistry& DefaultBoxes::GetRegistry() {
+  return GetDefaults()._types;
+}
+
+const BoxTypeSet& DefaultBoxes::GetContainers() {
+  return GetDefaults()._containers;
+}
+
+DefaultBoxes::DefaultBoxes() {
   this->RegisterContainerBox("moov");
   this->RegisterContainerBox("trak");
   this->RegisterContainerBox("edts");
@@ -295,116 +1475,47 @@ void Parser::IMPL::RegisterDefaultBoxes() {
   this->RegisterContainerBox("tapt");
   this->RegisterContainerBox("schi");
 
-  this->RegisterBox("ftyp", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<FTYP>();
-  });
-  this->RegisterBox("mvhd", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<MVHD>();
-  });
-  this->RegisterBox("tkhd", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<TKHD>();
-  });
-  this->RegisterBox("meta", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<META>();
-  });
-  this->RegisterBox("hdlr", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<HDLR>();
-  });
-  this->RegisterBox("mdhd", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<MDHD>();
-  });
-  this->RegisterBox("pitm", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<PITM>();
-  });
-  this->RegisterBox("iinf", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<IINF>();
-  });
-  this->RegisterBox("dref", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<DREF>();
-  });
-  this->RegisterBox("url ", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<URL>();
-  });
-  this->RegisterBox("urn ", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<URN>();
-  });
-  this->RegisterBox("iloc", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<ILOC>();
-  });
-  this->RegisterBox("iref", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<IREF>();
-  });
-  this->RegisterBox("infe", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<INFE>();
-  });
-  this->RegisterBox("irot", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<IROT>();
-  });
-  this->RegisterBox("hvcC", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<HVCC>();
-  });
-  this->RegisterBox("avcC", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<AVCC>();
-  });
-  this->RegisterBox("dimg", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<DIMG>();
-  });
-  this->RegisterBox("thmb", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<THMB>();
-  });
-  this->RegisterBox("cdsc", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<CDSC>();
-  });
-  this->RegisterBox("colr", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<COLR>();
-  });
-  this->RegisterBox("ispe", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<ISPE>();
-  });
-  this->RegisterBox("ipma", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<IPMA>();
-  });
-  this->RegisterBox("pixi", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<PIXI>();
-  });
-  this->RegisterBox("ipco", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<IPCO>();
-  });
-  this->RegisterBox("stsd", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<STSD>();
-  });
-  this->RegisterBox("stss", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<STSS>();
-  });
-  this->RegisterBox("stts", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<STTS>();
-  });
-  this->RegisterBox("ctts", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<CTTS>();
-  });
-  this->RegisterBox("frma", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<FRMA>();
-  });
-  this->RegisterBox("schm", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<SCHM>();
-  });
-  this->RegisterBox("hvc1", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<HVC1>();
-  });
-  this->RegisterBox("hev1", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<HEV1>();
-  });
-  this->RegisterBox("avc1", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<AVC1>();
-  });
-  this->RegisterBox("avc3", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<AVC3>();
-  });
-  this->RegisterBox("av01", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<AV01>();
-  });
-  this->RegisterBox("mp4a", [=]() -> std::shared_ptr<Box> {
-    return std::make_shared<MP4A>();
-  });
+  this->RegisterBox<FTYP>("ftyp");
+  this->RegisterBox<MVHD>("mvhd");
+  this->RegisterBox<TKHD>("tkhd");
+  this->RegisterContainerBox<META>("meta");
+  this->RegisterBox<HDLR>("hdlr");
+  this->RegisterBox<MDHD>("mdhd");
+  this->RegisterBox<PITM>("pitm");
+  this->RegisterBox<IINF>("iinf");
+  this->RegisterBox<DREF>("dref");
+  this->RegisterBox<URL>("url ");
+  this->RegisterBox<URN>("urn ");
+  this->RegisterBox<ILOC>("iloc");
+  this->RegisterBox<IREF>("iref");
+  this->RegisterBox<INFE>("infe");
+  this->RegisterBox<IROT>("irot");
+  this->RegisterBox<HVCC>("hvcC");
+  this->RegisterBox<AVCC>("avcC");
+  this->RegisterBox<DIMG>("dimg");
+  this->RegisterBox<THMB>("thmb");
+  this->RegisterBox<CDSC>("cdsc");
+  this->RegisterBox<COLR>("colr");
+  this->RegisterBox<ISPE>("ispe");
+  this->RegisterBox<IPMA>("ipma");
+  this->RegisterBox<PIXI>("pixi");
+  this->RegisterContainerBox<IPCO>("ipco");
+  this->RegisterBox<STSD>("stsd");
+  this->RegisterBox<STSS>("stss");
+  this->RegisterBox<STTS>("stts");
+  this->RegisterBox<CTTS>("ctts");
+  this->RegisterBox<STSZ>("stsz");
+  this->RegisterBox<STZ2>("stz2");
+  this->RegisterBox<STSC>("stsc");
+  this->RegisterBox<STCO>("stco");
+  this->RegisterBox<CO64>("co64");
+  this->RegisterBox<FRMA>("frma");
+  this->RegisterBox<SCHM>("schm");
+  this->RegisterBox<HVC1>("hvc1");
+  this->RegisterBox<HEV1>("hev1");
+  this->RegisterBox<AVC1>("avc1");
+  this->RegisterBox<AVC3>("avc3");
+  this->RegisterBox<AV01>("av01");
+  this->RegisterBox<MP4A>("mp4a");
 }
 }  // namespace ISOBMFF
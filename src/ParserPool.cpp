@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ParserPool.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ParserPool.hpp>
+#include <ThreadPool.hpp>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ISOBMFF {
+class ParserPool::IMPL {
+ public:
+  IMPL(const Parser& parser, size_t workers);
+  ~IMPL();
+
+  void Run(size_t count, const std::function<Error(Parser&, size_t)>& parse,
+           const Callback& callback);
+  bool Next(size_t worker, size_t& index);
+
+  // the files left to a worker, taken from the front by the worker,
+  // and from the back by idle workers
+  struct Queue {
+    std::mutex _mutex;
+    std::deque<size_t> _files;
+  };
+
+  Parser _parser;
+  std::vector<Parser> _parsers;
+  std::vector<std::unique_ptr<Queue> > _queues;
+  ThreadPool _pool;
+  std::mutex _batch;
+};
+
+static size_t WorkerCount(size_t threads) {
+  if (threads != 0) {
+    return threads;
+  }
+
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+ParserPool::ParserPool(const Parser& parser, size_t threads)
+    : impl(std::make_unique<IMPL>(parser, WorkerCount(threads))) {}
+
+ParserPool::~ParserPool() {}
+
+size_t ParserPool::GetWorkerCount() const {
+  return this->impl->_parsers.size();
+}
+
+void ParserPool::Parse(const std::vector<std::string>& paths,
+                       const Callback& callback) {
+  this->impl->Run(
+      paths.size(),
+      [&](Parser& parser, size_t i) { return parser.Parse(paths[i]); },
+      callback);
+}
+
+void ParserPool::Parse(const std::vector<Buffer>& buffers,
+                       const Callback& callback) {
+  this->impl->Run(
+      buffers.size(),
+      [&](Parser& parser, size_t i) {
+        return parser.Parse(buffers[i].first, buffers[i].second);
+      },
+      callback);
+}
+
+ParserPool::IMPL::IMPL(const Parser& parser, size_t workers)
+    : _parser(parser), _parsers(workers, parser), _pool(workers) {
+  for (size_t i = 0; i < workers; i++) {
+    this->_queues.push_back(std::make_unique<Queue>());
+  }
+}
+
+ParserPool::IMPL::~IMPL() {}
+
+void ParserPool::IMPL::Run(
+    size_t count, const std::function<Error(Parser&, size_t)>& parse,
+    const Callback& callback) {
+  std::lock_guard<std::mutex> batch(this->_batch);
+  size_t workers = this->_parsers.size();
+  std::vector<ThreadPool::Task> tasks;
+
+  // neighbouring files go to the same worker first
+  for (size_t w = 0; w < workers; w++) {
+    std::lock_guard<std::mutex> lock(this->_queues[w]->_mutex);
+
+    for (size_t i = w * count / workers; i < (w + 1) * count / workers; i++) {
+      this->_queues[w]->_files.push_back(i);
+    }
+  }
+
+  for (size_t w = 0; w < workers; w++) {
+    tasks.push_back([this, w, &parse, &callback]() {
+      Parser& parser = this->_parsers[w];
+      size_t i;
+
+      while (this->Next(w, i)) {
+        Error err = parse(parser, i);
+
+        if (callback != nullptr) {
+          callback(i, err, (err) ? nullptr : parser.GetFile());
+        }
+      }
+
+      // the last parsed file is not kept past the batch
+      parser = this->_parser;
+    });
+  }
+
+  this->_pool.Run(tasks);
+}
+
+bool ParserPool::IMPL::Next(size_t worker, size_t& index) {
+  size_t workers = this->_queues.size();
+
+  for (size_t n = 0; n < workers; n++) {
+    Queue& queue = *(this->_queues[(worker + n) % workers]);
+    std::lock_guard<std::mutex> lock(queue._mutex);
+
+    if (queue._files.empty()) {
+      continue;
+    }
+
+    if (n == 0) {
+      index = queue._files.front();
+      queue._files.pop_front();
+    } else {
+      index = queue._files.back();
+      queue._files.pop_back();
+    }
+
+    return true;
+  }
+
+  return false;
+}
+}  // namespace ISOBMFF
@@ -28,12 +28,13 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <Parser.hpp>
 #include <SCHM.hpp>
 #include <cstdint>
 
 namespace ISOBMFF {
-class SCHM::IMPL {
+class SCHM::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        STSC.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <Arena.hpp>
+#include <Parser.hpp>
+#include <STSC.hpp>
+#include <cstdint>
+#include <limits>
+
+namespace ISOBMFF {
+class STSC::IMPL : public Arena::Object {
+ public:
+  IMPL();
+  IMPL(const IMPL& o);
+  ~IMPL();
+
+  // first_chunk, samples_per_chunk and sample_description_index, per entry
+  std::vector<uint32_t> _entries;
+};
+
+STSC::STSC() : FullBox("stsc"), impl(std::make_unique<IMPL>()) {}
+
+STSC::STSC(const STSC& o)
+    : FullBox(o), impl(std::make_unique<IMPL>(*(o.impl))) {}
+
+STSC::STSC(STSC&& o) noexcept : FullBox(std::move(o)), impl(std::move(o.impl)) {
+  o.impl = nullptr;
+}
+
+STSC::~STSC() {}
+
+STSC& STSC::operator=(STSC o) {
+  FullBox::operator=(o);
+  swap(*(this), o);
+
+  return *(this);
+}
+
+void swap(STSC& o1, STSC& o2) {
+  using std::swap;
+
+  swap(static_cast<FullBox&>(o1), static_cast<FullBox&>(o2));
+  swap(o1.impl, o2.impl);
+}
+
+Error STSC::ReadData(Parser& parser, BinaryStream& stream) {
+  Error err;
+
+  err = FullBox::ReadData(parser, stream);
+  if (err) return err;
+
+  uint32_t entry_count;
+  err = stream.ReadBigEndianUInt32(entry_count);
+  if (err) return err;
+
+  if (entry_count > stream.AvailableBytes() / 12) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  std::vector<uint32_t> entries(static_cast<size_t>(entry_count) * 3);
+  err = stream.ReadBigEndianUInt32Array(entries.data(), entries.size());
+  if (err) return err;
+
+  this->impl->_entries = std::move(entries);
+
+  return Error();
+}
+
+std::vector<std::pair<std::string, std::string> >
+STSC::GetDisplayableProperties() const {
+  auto props(FullBox::GetDisplayableProperties());
+
+  for (size_t index = 0; index < this->GetEntryCount(); index++) {
+    props.push_back(
+        {"First Chunk", std::to_string(this->GetFirstChunk(index))});
+    props.push_back(
+        {"Samples Per Chunk", std::to_string(this->GetSamplesPerChunk(index))});
+    props.push_back({"Sample Description Index",
+                     std::to_string(this->GetSampleDescriptionIndex(index))});
+  }
+
+  return props;
+}
+
+size_t STSC::GetEntryCount() const { return this->impl->_entries.size() / 3; }
+
+uint32_t STSC::GetFirstChunk(size_t index) const {
+  return this->impl->_entries[index * 3];
+}
+
+uint32_t STSC::GetSamplesPerChunk(size_t index) const {
+  return this->impl->_entries[index * 3 + 1];
+}
+
+uint32_t STSC::GetSampleDescriptionIndex(size_t index) const {
+  return this->impl->_entries[index * 3 + 2];
+}
+
+Error STSC::GetChunks(const ChunkOffsets& offsets,
+                      std::vector<Chunk>& chunks) const {
+  const std::vector<uint32_t>& entries = this->impl->_entries;
+  size_t chunk_count = offsets.GetEntryCount();
+  size_t entry_count = this->GetEntryCount();
+
+  chunks.clear();
+
+  if (chunk_count == 0) {
+    return Error();
+  }
+
+  // the first entry describes the first chunk, and each entry runs until the
+  // next one, or until the last chunk
+  if (entry_count == 0 || entries[0] != 1) {
+    return Error(ErrorCode::InvalidBoxData, "Chunks without samples");
+  }
+
+  chunks.reserve(chunk_count);
+
+  uint64_t sample = 0;
+
+  for (size_t i = 0; i < entry_count && chunks.size() < chunk_count; i++) {
+    uint32_t first_chunk = entries[i * 3];
+    uint32_t samples_per_chunk = entries[i * 3 + 1];
+    uint32_t sample_description_index = entries[i * 3 + 2];
+    size_t last_chunk = chunk_count;
+
+    if (i + 1 < entry_count) {
+      if (entries[(i + 1) * 3] <= first_chunk) {
+        return Error(ErrorCode::InvalidBoxData,
+                     "Chunk numbers are not increasing");
+      }
+
+      last_chunk = std::min<size_t>(entries[(i + 1) * 3] - 1, chunk_count);
+    }
+
+    for (size_t chunk = first_chunk; chunk <= last_chunk; chunk++) {
+      Chunk c;
+      c.offset = offsets.GetChunkOffset(chunk - 1);
+      c.firstSample = static_cast<uint32_t>(sample);
+      c.sampleCount = samples_per_chunk;
+      c.sampleDescriptionIndex = sample_description_index;
+      chunks.push_back(c);
+
+      sample += samples_per_chunk;
+      if (sample > std::numeric_limits<uint32_t>::max()) {
+        chunks.clear();
+        return Error(ErrorCode::InvalidBoxData, "Too many samples");
+      }
+    }
+  }
+
+  return Error();
+}
+
+STSC::IMPL::IMPL() {}
+
+STSC::IMPL::IMPL(const IMPL& o) : _entries(o._entries) {}
+
+STSC::IMPL::~IMPL() {}
+}  // namespace ISOBMFF
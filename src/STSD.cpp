@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
-#include <ContainerBox.hpp>
+#include <Arena.hpp>
+#include <Parser.hpp>
 #include <STSD.hpp>
 
 namespace ISOBMFF {
-class STSD::IMPL {
+class STSD::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -67,7 +68,6 @@ void swap(STSD& o1, STSD& o2) {
 }
 
 Error STSD::ReadData(Parser& parser, BinaryStream& stream) {
-  ContainerBox container("????");
   Error err;
 
   err = FullBox::ReadData(parser, stream);
@@ -77,10 +77,10 @@ Error STSD::ReadData(Parser& parser, BinaryStream& stream) {
   err = stream.ReadBigEndianUInt32(temp);
   if (err) return err;
 
-  err = container.ReadData(parser, stream);
-  if (err) return err;
+  this->impl->_boxes.clear();
 
-  this->impl->_boxes = container.GetBoxes();
+  err = parser.ReadChildren(*(this), stream);
+  if (err) return err;
 
   return Error();
 }
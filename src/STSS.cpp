@@ -28,21 +28,44 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <Parser.hpp>
 #include <STSS.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <mutex>
 
 namespace ISOBMFF {
-class STSS::IMPL {
+class STSS::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
   ~IMPL();
 
+  const std::vector<uint32_t>& Index();
+
   std::vector<uint32_t> _sample_number;
+
+  // the entries sorted, without duplicates nor zeros, when they are not
+  // already, and one bit per sample number up to the largest one, unless
+  // there are too many; built when first needed
+  std::vector<uint32_t> _sorted;
+  std::vector<uint64_t> _bits;
+  bool _is_sorted;
+  std::atomic<bool> _indexed;
+  std::mutex _index_mutex;
 };
 
+// the largest bitset, in bits, enough for the largest sample tables
+static const uint64_t MaxBitCount = uint64_t(1) << 26;
+
+// the largest number of bits per entry, so a few large sample numbers do
+// not allocate a bitset out of proportion with the box; 256 covers the
+// usual sync sample intervals, in bytes 8 times the entries themselves
+static const uint64_t MaxBitsPerEntry = 256;
+
 STSS::STSS() : FullBox("stss"), impl(std::make_unique<IMPL>()) {}
 
 STSS::STSS(const STSS& o)
@@ -78,12 +101,20 @@ Error STSS::ReadData(Parser& parser, BinaryStream& stream) {
   err = stream.ReadBigEndianUInt32(entry_count);
   if (err) return err;
 
-  for (uint32_t i = 0; i < entry_count; i++) {
-    uint32_t temp;
-    err = stream.ReadBigEndianUInt32(temp);
-    if (err) return err;
-    this->impl->_sample_number.push_back(temp);
+  if (entry_count > stream.AvailableBytes() / 4) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
   }
+
+  std::vector<uint32_t> entries(entry_count);
+  err = stream.ReadBigEndianUInt32Array(entries.data(), entries.size());
+  if (err) return err;
+
+  this->impl->_sample_number = std::move(entries);
+  this->impl->_sorted.clear();
+  this->impl->_bits.clear();
+  this->impl->_indexed = false;
+
   return Error();
 }
 
@@ -105,9 +136,114 @@ uint32_t STSS::GetSampleNumber(size_t index) const {
   return this->impl->_sample_number[index];
 }
 
-STSS::IMPL::IMPL() {}
+bool STSS::IsSyncSample(uint64_t sample) const {
+  const std::vector<uint32_t>& sorted = this->impl->Index();
+  const std::vector<uint64_t>& bits = this->impl->_bits;
+  if (sample >= UINT32_MAX) {
+    return false;
+  }
 
-STSS::IMPL::IMPL(const IMPL& o) { this->_sample_number = o._sample_number; }
+  uint64_t number = sample + 1;
+
+  if (!bits.empty()) {
+    return (number / 64 < bits.size()) &&
+           ((bits[number / 64] >> (number % 64)) & 1);
+  }
+
+  return std::binary_search(sorted.begin(), sorted.end(),
+                            static_cast<uint32_t>(number));
+}
+
+bool STSS::GetPreviousSyncSample(uint64_t sample, uint64_t& sync) const {
+  const std::vector<uint32_t>& sorted = this->impl->Index();
+  uint64_t number = (sample >= UINT32_MAX) ? UINT32_MAX : sample + 1;
+
+  // the last sync sample at or before the sample
+  auto it = std::upper_bound(sorted.begin(), sorted.end(),
+                             static_cast<uint32_t>(number));
+
+  if (it == sorted.begin()) {
+    return false;
+  }
+
+  sync = *(it - 1) - 1;
+
+  return true;
+}
+
+bool STSS::GetNextSyncSample(uint64_t sample, uint64_t& sync) const {
+  const std::vector<uint32_t>& sorted = this->impl->Index();
+  if (sample >= UINT32_MAX) {
+    return false;
+  }
+
+  uint64_t number = sample + 1;
+
+  // the first sync sample at or after the sample
+  auto it = std::lower_bound(sorted.begin(), sorted.end(),
+                             static_cast<uint32_t>(number));
+
+  if (it == sorted.end()) {
+    return false;
+  }
+
+  sync = *(it) - 1;
+
+  return true;
+}
+
+STSS::IMPL::IMPL() : _is_sorted(false), _indexed(false) {}
+
+STSS::IMPL::IMPL(const IMPL& o)
+    : _sample_number(o._sample_number), _is_sorted(false), _indexed(false) {}
+
+const std::vector<uint32_t>& STSS::IMPL::Index() {
+  if (!this->_indexed.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(this->_index_mutex);
+
+    if (!this->_indexed.load(std::memory_order_relaxed)) {
+      const std::vector<uint32_t>& numbers = this->_sample_number;
+
+      // entries are increasing sample numbers, in valid boxes
+      this->_is_sorted = true;
+
+      for (size_t i = 0; i < numbers.size(); i++) {
+        if (numbers[i] == 0 || (i > 0 && numbers[i] <= numbers[i - 1])) {
+          this->_is_sorted = false;
+          break;
+        }
+      }
+
+      if (!this->_is_sorted) {
+        this->_sorted = numbers;
+        std::sort(this->_sorted.begin(), this->_sorted.end());
+        this->_sorted.erase(
+            std::unique(this->_sorted.begin(), this->_sorted.end()),
+            this->_sorted.end());
+        this->_sorted.erase(
+            std::remove(this->_sorted.begin(), this->_sorted.end(), 0u),
+            this->_sorted.end());
+      }
+
+      const std::vector<uint32_t>& sorted =
+          this->_is_sorted ? this->_sample_number : this->_sorted;
+
+      // without a bitset, sync samples are checked in O(log(entries))
+      if (!sorted.empty() && sorted.back() < MaxBitCount &&
+          sorted.back() / MaxBitsPerEntry < sorted.size()) {
+        this->_bits.assign(sorted.back() / 64 + 1, 0);
+
+        for (uint32_t number : sorted) {
+          this->_bits[number / 64] |= uint64_t(1) << (number % 64);
+        }
+      }
+
+      this->_indexed.store(true, std::memory_order_release);
+    }
+  }
+
+  return this->_is_sorted ? this->_sample_number : this->_sorted;
+}
 
 STSS::IMPL::~IMPL() {}
 }  // namespace ISOBMFF
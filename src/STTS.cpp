@@ -28,20 +28,33 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <Parser.hpp>
 #include <STTS.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <mutex>
 
 namespace ISOBMFF {
-class STTS::IMPL {
+class STTS::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
   ~IMPL();
 
-  std::vector<uint32_t> _sample_count;
-  std::vector<uint32_t> _sample_offset;
+  void Index();
+
+  // interleaved (sample_count, sample_delta) pairs, as stored in the box
+  std::vector<uint32_t> _entries;
+
+  // the number of samples before each entry, and their duration, with one
+  // more value for the end of the last entry; built when first needed
+  std::vector<uint64_t> _first_sample;
+  std::vector<uint64_t> _first_time;
+  std::atomic<bool> _indexed;
+  std::mutex _index_mutex;
 };
 
 STTS::STTS() : FullBox("stts"), impl(std::make_unique<IMPL>()) {}
@@ -79,16 +92,20 @@ Error STTS::ReadData(Parser& parser, BinaryStream& stream) {
   err = stream.ReadBigEndianUInt32(entry_count);
   if (err) return err;
 
-  for (uint32_t i = 0; i < entry_count; i++) {
-    uint32_t temp;
-    err = stream.ReadBigEndianUInt32(temp);
-    if (err) return err;
-    this->impl->_sample_count.push_back(temp);
-
-    err = stream.ReadBigEndianUInt32(temp);
-    if (err) return err;
-    this->impl->_sample_offset.push_back(temp);
+  if (entry_count > stream.AvailableBytes() / 8) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
   }
+
+  std::vector<uint32_t> entries(static_cast<size_t>(entry_count) * 2);
+  err = stream.ReadBigEndianUInt32Array(entries.data(), entries.size());
+  if (err) return err;
+
+  this->impl->_entries = std::move(entries);
+  this->impl->_first_sample.clear();
+  this->impl->_first_time.clear();
+  this->impl->_indexed = false;
+
   return Error();
 }
 
@@ -106,21 +123,100 @@ STTS::GetDisplayableProperties() const {
   return props;
 }
 
-size_t STTS::GetEntryCount() const { return this->impl->_sample_count.size(); }
+size_t STTS::GetEntryCount() const { return this->impl->_entries.size() / 2; }
 
 uint32_t STTS::GetSampleCount(size_t index) const {
-  return this->impl->_sample_count[index];
+  return this->impl->_entries[index * 2];
 }
 
 uint32_t STTS::GetSampleOffset(size_t index) const {
-  return this->impl->_sample_offset[index];
+  return this->impl->_entries[index * 2 + 1];
+}
+
+uint64_t STTS::GetTotalSampleCount() const {
+  this->impl->Index();
+
+  return this->impl->_first_sample.back();
+}
+
+uint64_t STTS::GetDuration() const {
+  this->impl->Index();
+
+  return this->impl->_first_time.back();
+}
+
+uint64_t STTS::GetDecodingTime(uint64_t sample) const {
+  this->impl->Index();
+
+  const std::vector<uint64_t>& first_sample = this->impl->_first_sample;
+  size_t count = this->GetEntryCount();
+
+  // the last entry starting at or before the sample, skipping empty ones
+  size_t index = static_cast<size_t>(
+      std::upper_bound(first_sample.begin(), first_sample.end(), sample) -
+      first_sample.begin() - 1);
+
+  if (index >= count) {
+    return this->impl->_first_time.back();
+  }
+
+  return this->impl->_first_time[index] +
+         (sample - first_sample[index]) * this->GetSampleOffset(index);
+}
+
+uint64_t STTS::GetSampleAtTime(uint64_t time) const {
+  this->impl->Index();
+
+  const std::vector<uint64_t>& first_time = this->impl->_first_time;
+  size_t count = this->GetEntryCount();
+
+  // the last entry starting at or before the time, which has a duration
+  size_t index = static_cast<size_t>(
+      std::upper_bound(first_time.begin(), first_time.end(), time) -
+      first_time.begin() - 1);
+
+  if (index >= count) {
+    return this->impl->_first_sample.back();
+  }
+
+  return this->impl->_first_sample[index] +
+         (time - first_time[index]) / this->GetSampleOffset(index);
 }
 
-STTS::IMPL::IMPL() {}
+STTS::IMPL::IMPL() : _indexed(false) {}
+
+STTS::IMPL::IMPL(const IMPL& o) : _entries(o._entries), _indexed(false) {}
+
+void STTS::IMPL::Index() {
+  if (this->_indexed.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->_index_mutex);
+
+  if (this->_indexed.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  size_t count = this->_entries.size() / 2;
+  uint64_t sample = 0;
+  uint64_t time = 0;
+
+  this->_first_sample.resize(count + 1);
+  this->_first_time.resize(count + 1);
+
+  for (size_t i = 0; i < count; i++) {
+    this->_first_sample[i] = sample;
+    this->_first_time[i] = time;
+    sample += this->_entries[i * 2];
+    time += static_cast<uint64_t>(this->_entries[i * 2]) *
+            this->_entries[i * 2 + 1];
+  }
+
+  this->_first_sample[count] = sample;
+  this->_first_time[count] = time;
 
-STTS::IMPL::IMPL(const IMPL& o) {
-  this->_sample_count = o._sample_count;
-  this->_sample_offset = o._sample_offset;
+  this->_indexed.store(true, std::memory_order_release);
 }
 
 STTS::IMPL::~IMPL() {}
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        STZ2.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <Arena.hpp>
+#include <Parser.hpp>
+#include <STZ2.hpp>
+#include <cstdint>
+
+namespace ISOBMFF {
+class STZ2::IMPL : public Arena::Object {
+ public:
+  IMPL();
+  IMPL(const IMPL& o);
+  ~IMPL();
+
+  uint8_t _field_size;
+  uint32_t _sample_count;
+
+  // the packed sizes, as stored in the box, and decoded on access
+  std::vector<uint8_t> _entry_size;
+};
+
+STZ2::STZ2() : FullBox("stz2"), impl(std::make_unique<IMPL>()) {}
+
+STZ2::STZ2(const STZ2& o)
+    : FullBox(o), impl(std::make_unique<IMPL>(*(o.impl))) {}
+
+STZ2::STZ2(STZ2&& o) noexcept : FullBox(std::move(o)), impl(std::move(o.impl)) {
+  o.impl = nullptr;
+}
+
+STZ2::~STZ2() {}
+
+STZ2& STZ2::operator=(STZ2 o) {
+  FullBox::operator=(o);
+  swap(*(this), o);
+
+  return *(this);
+}
+
+void swap(STZ2& o1, STZ2& o2) {
+  using std::swap;
+
+  swap(static_cast<FullBox&>(o1), static_cast<FullBox&>(o2));
+  swap(o1.impl, o2.impl);
+}
+
+Error STZ2::ReadData(Parser& parser, BinaryStream& stream) {
+  Error err;
+
+  err = FullBox::ReadData(parser, stream);
+  if (err) return err;
+
+  // unsigned int(24) reserved = 0, then unsigned int(8) field_size
+  uint32_t temp32;
+  err = stream.ReadBigEndianUInt32(temp32);
+  if (err) return err;
+  uint8_t field_size = static_cast<uint8_t>(temp32 & 0xFF);
+
+  if (field_size != 4 && field_size != 8 && field_size != 16) {
+    return Error(ErrorCode::InvalidBoxData, "Invalid field size");
+  }
+
+  uint32_t sample_count;
+  err = stream.ReadBigEndianUInt32(sample_count);
+  if (err) return err;
+
+  uint64_t length = (static_cast<uint64_t>(sample_count) * field_size + 7) / 8;
+
+  if (length > stream.AvailableBytes()) {
+    return Error(ErrorCode::InsufficientData,
+                 "Insufficient data available for read");
+  }
+
+  std::vector<uint8_t> entries;
+  err = stream.Read(entries, static_cast<size_t>(length));
+  if (err) return err;
+
+  this->impl->_field_size = field_size;
+  this->impl->_sample_count = sample_count;
+  this->impl->_entry_size = std::move(entries);
+
+  return Error();
+}
+
+std::vector<std::pair<std::string, std::string> >
+STZ2::GetDisplayableProperties() const {
+  auto props(FullBox::GetDisplayableProperties());
+
+  props.push_back({"Field Size", std::to_string(this->GetFieldSize())});
+  props.push_back({"Sample Count", std::to_string(this->GetSampleCount())});
+
+  for (uint32_t index = 0; index < this->GetSampleCount(); index++) {
+    props.push_back(
+        {"Entry Size", std::to_string(this->GetSampleSize(index))});
+  }
+
+  return props;
+}
+
+uint8_t STZ2::GetFieldSize() const { return this->impl->_field_size; }
+
+uint32_t STZ2::GetSampleCount() const { return this->impl->_sample_count; }
+
+uint32_t STZ2::GetSampleSize(size_t index) const {
+  const uint8_t* entries = this->impl->_entry_size.data();
+
+  switch (this->impl->_field_size) {
+    case 4:
+      // two samples per byte, the first one in the upper nibble
+      return (index % 2 == 0) ? (entries[index / 2] >> 4)
+                              : (entries[index / 2] & 0x0F);
+
+    case 8:
+      return entries[index];
+
+    case 16:
+      return (static_cast<uint32_t>(entries[index * 2]) << 8) |
+             entries[index * 2 + 1];
+
+    default:
+      return 0;
+  }
+}
+
+STZ2::IMPL::IMPL() : _field_size(0), _sample_count(0) {}
+
+STZ2::IMPL::IMPL(const IMPL& o)
+    : _field_size(o._field_size),
+      _sample_count(o._sample_count),
+      _entry_size(o._entry_size) {}
+
+STZ2::IMPL::~IMPL() {}
+}  // namespace ISOBMFF
@@ -0,0 +1,413 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SampleTable.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <CO64.hpp>
+#include <CTTS.hpp>
+#include <ContainerBox.hpp>
+#include <STCO.hpp>
+#include <STSC.hpp>
+#include <STSS.hpp>
+#include <STSZ.hpp>
+#include <STTS.hpp>
+#include <STZ2.hpp>
+#include <SampleTable.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace ISOBMFF {
+class SampleTable::IMPL {
+ public:
+  IMPL();
+  IMPL(const IMPL& o);
+  ~IMPL();
+
+  Error Read(const Container& stbl, uint64_t fileSize);
+  void ReadTimes(const STTS& stts, const CTTS* ctts);
+  Error ReadOffsets(const std::vector<STSC::Chunk>& chunks,
+                    uint64_t fileSize);
+
+  size_t _max_sample_count;
+
+  // one array per property, indexed by sample number
+  std::vector<uint64_t> _offset;
+  std::vector<uint32_t> _size;
+  std::vector<uint64_t> _decoding_time;
+
+  // empty without a ctts box
+  std::vector<int32_t> _composition_offset;
+
+  // nullptr without a stss box, as all samples are then sync samples
+  std::shared_ptr<STSS> _sync;
+};
+
+constexpr size_t SampleTable::DefaultMaxSampleCount;
+
+// finds a box, and reads it if reading it was deferred
+template <class T>
+static Error FindBox(const Container& container, const std::string& name,
+                     std::shared_ptr<T>& result) {
+  result = nullptr;
+
+  for (const auto& box : container.GetBoxes()) {
+    if (box->GetName() == name) {
+      Error err = box->Load();
+      if (err) return err;
+
+      result = std::dynamic_pointer_cast<T>(box);
+      return Error();
+    }
+  }
+
+  return Error();
+}
+
+static Error MissingBox(const std::string& name) {
+  return Error(ErrorCode::InvalidBoxData, "Missing " + name + " box");
+}
+
+static bool IsInFile(uint64_t offset, uint64_t size, uint64_t fileSize) {
+  return size <= fileSize && offset <= fileSize - size;
+}
+
+SampleTable::SampleTable() : impl(std::make_unique<IMPL>()) {}
+
+SampleTable::SampleTable(const SampleTable& o)
+    : impl(std::make_unique<IMPL>(*(o.impl))) {}
+
+SampleTable::SampleTable(SampleTable&& o) noexcept : impl(std::move(o.impl)) {
+  o.impl = nullptr;
+}
+
+SampleTable::~SampleTable() {}
+
+SampleTable& SampleTable::operator=(SampleTable o) {
+  swap(*(this), o);
+
+  return *(this);
+}
+
+void swap(SampleTable& o1, SampleTable& o2) {
+  using std::swap;
+
+  swap(o1.impl, o2.impl);
+}
+
+size_t SampleTable::GetMaxSampleCount() const {
+  return this->impl->_max_sample_count;
+}
+
+void SampleTable::SetMaxSampleCount(size_t value) {
+  this->impl->_max_sample_count = value;
+}
+
+Error SampleTable::Read(const Container& trak, uint64_t fileSize) {
+  std::shared_ptr<ContainerBox> mdia;
+  std::shared_ptr<ContainerBox> minf;
+  std::shared_ptr<ContainerBox> stbl;
+  Error err;
+
+  err = FindBox(trak, "mdia", mdia);
+  if (err) return err;
+  if (mdia == nullptr) return MissingBox("mdia");
+
+  err = FindBox(*(mdia), "minf", minf);
+  if (err) return err;
+  if (minf == nullptr) return MissingBox("minf");
+
+  err = FindBox(*(minf), "stbl", stbl);
+  if (err) return err;
+  if (stbl == nullptr) return MissingBox("stbl");
+
+  // the table is only replaced once all of it is read
+  std::unique_ptr<IMPL> table(std::make_unique<IMPL>());
+
+  table->_max_sample_count = this->impl->_max_sample_count;
+
+  err = table->Read(*(stbl), fileSize);
+  if (err) return err;
+
+  this->impl = std::move(table);
+
+  return Error();
+}
+
+size_t SampleTable::GetSampleCount() const { return this->impl->_size.size(); }
+
+uint64_t SampleTable::GetSampleOffset(size_t index) const {
+  return this->impl->_offset[index];
+}
+
+uint32_t SampleTable::GetSampleSize(size_t index) const {
+  return this->impl->_size[index];
+}
+
+uint64_t SampleTable::GetDecodingTime(size_t index) const {
+  return this->impl->_decoding_time[index];
+}
+
+int64_t SampleTable::GetCompositionTime(size_t index) const {
+  int64_t time = static_cast<int64_t>(this->impl->_decoding_time[index]);
+
+  if (this->impl->_composition_offset.empty()) {
+    return time;
+  }
+
+  return time + this->impl->_composition_offset[index];
+}
+
+bool SampleTable::IsSyncSample(size_t index) const {
+  return this->impl->_sync == nullptr ||
+         this->impl->_sync->IsSyncSample(index);
+}
+
+bool SampleTable::GetPreviousSyncSample(size_t index, size_t& sync) const {
+  uint64_t sample = index;
+
+  if (index >= this->GetSampleCount()) {
+    return false;
+  }
+
+  if (this->impl->_sync != nullptr &&
+      !this->impl->_sync->GetPreviousSyncSample(index, sample)) {
+    return false;
+  }
+
+  sync = static_cast<size_t>(sample);
+
+  return true;
+}
+
+bool SampleTable::GetNextSyncSample(size_t index, size_t& sync) const {
+  uint64_t sample = index;
+
+  if (index >= this->GetSampleCount()) {
+    return false;
+  }
+
+  if (this->impl->_sync != nullptr &&
+      (!this->impl->_sync->GetNextSyncSample(index, sample) ||
+       sample >= this->GetSampleCount())) {
+    return false;
+  }
+
+  sync = static_cast<size_t>(sample);
+
+  return true;
+}
+
+SampleTable::IMPL::IMPL() : _max_sample_count(DefaultMaxSampleCount) {}
+
+SampleTable::IMPL::IMPL(const IMPL& o)
+    : _max_sample_count(o._max_sample_count),
+      _offset(o._offset),
+      _size(o._size),
+      _decoding_time(o._decoding_time),
+      _composition_offset(o._composition_offset),
+      _sync(o._sync) {}
+
+SampleTable::IMPL::~IMPL() {}
+
+Error SampleTable::IMPL::Read(const Container& stbl, uint64_t fileSize) {
+  std::shared_ptr<STSZ> stsz;
+  std::shared_ptr<STZ2> stz2;
+  std::shared_ptr<STTS> stts;
+  std::shared_ptr<CTTS> ctts;
+  std::shared_ptr<STSC> stsc;
+  std::shared_ptr<STCO> stco;
+  std::shared_ptr<CO64> co64;
+  Error err;
+
+  err = FindBox(stbl, "stsz", stsz);
+  if (err) return err;
+
+  if (stsz == nullptr) {
+    err = FindBox(stbl, "stz2", stz2);
+    if (err) return err;
+    if (stz2 == nullptr) return MissingBox("stsz");
+  }
+
+  uint64_t count = (stsz != nullptr) ? stsz->GetSampleCount()
+                                     : stz2->GetSampleCount();
+
+  if (count > this->_max_sample_count) {
+    return Error(ErrorCode::InvalidBoxData, "Too many samples");
+  }
+
+  // the box is indexed when first queried
+  err = FindBox(stbl, "stss", this->_sync);
+  if (err) return err;
+
+  if (count == 0) {
+    return Error();
+  }
+
+  err = FindBox(stbl, "stts", stts);
+  if (err) return err;
+  if (stts == nullptr) return MissingBox("stts");
+
+  err = FindBox(stbl, "ctts", ctts);
+  if (err) return err;
+
+  err = FindBox(stbl, "stsc", stsc);
+  if (err) return err;
+  if (stsc == nullptr) return MissingBox("stsc");
+
+  err = FindBox(stbl, "stco", stco);
+  if (err) return err;
+
+  if (stco == nullptr) {
+    err = FindBox(stbl, "co64", co64);
+    if (err) return err;
+    if (co64 == nullptr) return MissingBox("stco");
+  }
+
+  // the sample count is checked against the other tables before the
+  // samples are allocated, as a run-length entry can describe any number
+  // of samples
+  if (stts->GetTotalSampleCount() < count) {
+    return Error(ErrorCode::InvalidBoxData,
+                 "Samples without a decoding time");
+  }
+
+  const ChunkOffsets& offsets =
+      (stco != nullptr) ? static_cast<const ChunkOffsets&>(*(stco)) : *(co64);
+  std::vector<STSC::Chunk> chunks;
+
+  err = stsc->GetChunks(offsets, chunks);
+  if (err) return err;
+
+  if (chunks.empty() ||
+      uint64_t(chunks.back().firstSample) + chunks.back().sampleCount <
+          count) {
+    return Error(ErrorCode::InvalidBoxData, "Samples without a chunk");
+  }
+
+  // samples of a constant size are only described by the run-length
+  // tables, so their extents are checked first; other sizes are in a
+  // table as large as the samples, and are checked as they are read
+  if (stsz != nullptr && stsz->GetSampleSize() != 0) {
+    for (const auto& chunk : chunks) {
+      if (chunk.firstSample >= count) {
+        break;
+      }
+
+      uint64_t samples =
+          std::min<uint64_t>(chunk.sampleCount, count - chunk.firstSample);
+
+      if (!IsInFile(chunk.offset, samples * stsz->GetSampleSize(),
+                    fileSize)) {
+        return Error(ErrorCode::InvalidBoxData,
+                     "Samples past the end of the file");
+      }
+    }
+  }
+
+  this->_size.resize(static_cast<size_t>(count));
+
+  if (stsz != nullptr && stsz->GetSampleSize() != 0) {
+    std::fill(this->_size.begin(), this->_size.end(), stsz->GetSampleSize());
+  } else {
+    for (size_t i = 0; i < this->_size.size(); i++) {
+      this->_size[i] = (stsz != nullptr) ? stsz->GetSampleSize(i)
+                                         : stz2->GetSampleSize(i);
+    }
+  }
+
+  err = this->ReadOffsets(chunks, fileSize);
+  if (err) return err;
+
+  this->ReadTimes(*(stts), ctts.get());
+
+  return Error();
+}
+
+void SampleTable::IMPL::ReadTimes(const STTS& stts, const CTTS* ctts) {
+  size_t count = this->_size.size();
+  uint64_t time = 0;
+  size_t sample = 0;
+
+  this->_decoding_time.resize(count);
+
+  for (size_t i = 0; i < stts.GetEntryCount() && sample < count; i++) {
+    size_t run = std::min<size_t>(stts.GetSampleCount(i), count - sample);
+    uint32_t delta = stts.GetSampleOffset(i);
+
+    for (size_t j = 0; j < run; j++, sample++) {
+      this->_decoding_time[sample] = time;
+      time += delta;
+    }
+  }
+
+  if (ctts == nullptr) {
+    return;
+  }
+
+  // samples past the last entry have no offset
+  this->_composition_offset.resize(count, 0);
+
+  sample = 0;
+
+  for (size_t i = 0; i < ctts->GetEntryCount() && sample < count; i++) {
+    size_t run = std::min<size_t>(ctts->GetSampleCount(i), count - sample);
+
+    std::fill_n(this->_composition_offset.data() + sample, run,
+                ctts->GetSampleOffset(i));
+    sample += run;
+  }
+}
+
+Error SampleTable::IMPL::ReadOffsets(const std::vector<STSC::Chunk>& chunks,
+                                     uint64_t fileSize) {
+  size_t count = this->_size.size();
+  size_t sample = 0;
+
+  this->_offset.resize(count);
+
+  // samples are stored one after the other in their chunk
+  for (const auto& chunk : chunks) {
+    uint64_t offset = chunk.offset;
+    size_t end = std::min<size_t>(
+        static_cast<size_t>(chunk.firstSample) + chunk.sampleCount, count);
+
+    for (; sample < end; sample++) {
+      if (!IsInFile(offset, this->_size[sample], fileSize)) {
+        return Error(ErrorCode::InvalidBoxData,
+                     "Samples past the end of the file");
+      }
+
+      this->_offset[sample] = offset;
+      offset += this->_size[sample];
+    }
+  }
+
+  return Error();
+}
+}  // namespace ISOBMFF
@@ -28,13 +28,14 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <IREF.hpp>
 #include <Parser.hpp>
 #include <SingleItemTypeReferenceBox.hpp>
 #include <Utils.hpp>
 
 namespace ISOBMFF {
-class SingleItemTypeReferenceBox::IMPL {
+class SingleItemTypeReferenceBox::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -78,10 +79,9 @@ Error SingleItemTypeReferenceBox::ReadData(Parser& parser,
                                            BinaryStream& stream) {
   const IREF* iref;
   uint16_t count;
-  uint16_t i;
   Error err;
 
-  iref = static_cast<const IREF*>(parser.GetInfo("iref"));
+  iref = dynamic_cast<const IREF*>(parser.GetContext().GetParent());
 
   if (iref == nullptr) {
     return Box::ReadData(parser, stream);
@@ -96,11 +96,12 @@ Error SingleItemTypeReferenceBox::ReadData(Parser& parser,
     err = stream.ReadBigEndianUInt16(count);
     if (err) return err;
 
-    for (i = 0; i < count; i++) {
-      err = stream.ReadBigEndianUInt16(temp16);
-      if (err) return err;
-      this->AddToItemID(temp16);
-    }
+    std::vector<uint16_t> ids(count);
+    err = stream.ReadBigEndianUInt16Array(ids.data(), ids.size());
+    if (err) return err;
+
+    this->impl->_toItemIDs.insert(this->impl->_toItemIDs.end(), ids.begin(),
+                                  ids.end());
   } else if (iref->GetVersion() == 1) {
     uint32_t temp32;
     err = stream.ReadBigEndianUInt32(temp32);
@@ -110,10 +111,14 @@ Error SingleItemTypeReferenceBox::ReadData(Parser& parser,
     err = stream.ReadBigEndianUInt16(count);
     if (err) return err;
 
-    for (i = 0; i < count; i++) {
-      err = stream.ReadBigEndianUInt32(temp32);
-      if (err) return err;
-      this->AddToItemID(temp32);
+    size_t first = this->impl->_toItemIDs.size();
+    this->impl->_toItemIDs.resize(first + count);
+
+    err = stream.ReadBigEndianUInt32Array(this->impl->_toItemIDs.data() + first,
+                                          count);
+    if (err) {
+      this->impl->_toItemIDs.resize(first);
+      return err;
     }
   }
 
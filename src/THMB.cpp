@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <THMB.hpp>
 
 namespace ISOBMFF {
-class THMB::IMPL {
+class THMB::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
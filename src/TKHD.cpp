@@ -28,11 +28,12 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <TKHD.hpp>
 #include <cstring>
 
 namespace ISOBMFF {
-class TKHD::IMPL {
+class TKHD::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
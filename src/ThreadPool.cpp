@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ThreadPool.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ThreadPool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ISOBMFF {
+class ThreadPool::IMPL {
+ public:
+  IMPL(size_t threads);
+  ~IMPL();
+
+  void Work();
+
+  std::vector<std::thread> _threads;
+  std::deque<Task> _tasks;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _stopping;
+};
+
+/*
+ * Tasks given to Run, shared by the threads helping with them. Tasks
+ * are claimed by index, so each one runs exactly once. The tasks are
+ * not accessed once all of them are claimed, as Run may have returned.
+ */
+struct TaskBatch {
+  TaskBatch(const std::vector<ThreadPool::Task>& tasks)
+      : _tasks(tasks),
+        _count(tasks.size()),
+        _next(0),
+        _remaining(tasks.size()) {}
+
+  // runs tasks until none is left to claim
+  void Help() {
+    size_t i;
+
+    while ((i = this->_next.fetch_add(1)) < this->_count) {
+      this->_tasks[i]();
+
+      if (this->_remaining.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_condition.notify_all();
+      }
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+
+    this->_condition.wait(lock, [this]() { return this->_remaining == 0; });
+  }
+
+  const std::vector<ThreadPool::Task>& _tasks;
+  const size_t _count;
+  std::atomic<size_t> _next;
+  std::atomic<size_t> _remaining;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+};
+
+ThreadPool::ThreadPool(size_t threads)
+    : impl(std::make_unique<IMPL>(
+          (threads != 0)
+              ? threads
+              : std::max<size_t>(1, std::thread::hardware_concurrency()))) {}
+
+ThreadPool::~ThreadPool() {}
+
+ThreadPool& ThreadPool::GetDefault() {
+  static ThreadPool pool;
+
+  return pool;
+}
+
+size_t ThreadPool::GetThreadCount() const {
+  return this->impl->_threads.size();
+}
+
+void ThreadPool::Submit(const Task& task) {
+  {
+    std::lock_guard<std::mutex> lock(this->impl->_mutex);
+    this->impl->_tasks.push_back(task);
+  }
+
+  this->impl->_condition.notify_one();
+}
+
+void ThreadPool::Run(const std::vector<Task>& tasks) {
+  if (tasks.size() < 2) {
+    for (const auto& task : tasks) {
+      task();
+    }
+
+    return;
+  }
+
+  // helpers may start after the batch is done, so they share it
+  std::shared_ptr<TaskBatch> batch = std::make_shared<TaskBatch>(tasks);
+  size_t helpers = std::min(tasks.size() - 1, this->GetThreadCount());
+
+  for (size_t i = 0; i < helpers; i++) {
+    this->Submit([batch]() { batch->Help(); });
+  }
+
+  batch->Help();
+  batch->Wait();
+}
+
+ThreadPool::IMPL::IMPL(size_t threads) : _stopping(false) {
+  for (size_t i = 0; i < threads; i++) {
+    this->_threads.emplace_back([this]() { this->Work(); });
+  }
+}
+
+ThreadPool::IMPL::~IMPL() {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_stopping = true;
+  }
+
+  this->_condition.notify_all();
+
+  for (auto& thread : this->_threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::IMPL::Work() {
+  while (true) {
+    Task task;
+
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+
+      this->_condition.wait(lock, [this]() {
+        return this->_stopping || this->_tasks.empty() == false;
+      });
+
+      if (this->_tasks.empty()) {
+        return;
+      }
+
+      task = std::move(this->_tasks.front());
+      this->_tasks.pop_front();
+    }
+
+    task();
+  }
+}
+}  // namespace ISOBMFF
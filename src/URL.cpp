@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <URL.hpp>
 
 namespace ISOBMFF {
-class URL::IMPL {
+class URL::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
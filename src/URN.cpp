@@ -28,10 +28,11 @@
  * @author      Jean-David Gadina - www.digidna.net
  */
 
+#include <Arena.hpp>
 #include <URN.hpp>
 
 namespace ISOBMFF {
-class URN::IMPL {
+class URN::IMPL : public Arena::Object {
  public:
   IMPL();
   IMPL(const IMPL& o);
@@ -83,6 +83,28 @@ std::string ToHexString(uint32_t u) {
   return ss.str();
 }
 
+uint32_t FourCC(const std::string& s) {
+  if (s.size() != 4) {
+    return 0;
+  }
+
+  return (static_cast<uint32_t>(static_cast<uint8_t>(s[0])) << 24) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(s[1])) << 16) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(s[2])) << 8) |
+         static_cast<uint32_t>(static_cast<uint8_t>(s[3]));
+}
+
+std::string FourCCToString(uint32_t fourcc) {
+  std::string s(4, ' ');
+
+  s[0] = static_cast<char>((fourcc >> 24) & 0xFF);
+  s[1] = static_cast<char>((fourcc >> 16) & 0xFF);
+  s[2] = static_cast<char>((fourcc >> 8) & 0xFF);
+  s[3] = static_cast<char>(fourcc & 0xFF);
+
+  return s;
+}
+
 std::string ToHexString(uint64_t u) {
   std::stringstream ss;
 
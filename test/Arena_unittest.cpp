@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+#include <Arena.hpp>   // for Arena
+#include <ISOBMFF.hpp> // for various
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFArenaTest : public ::testing::Test {
+public:
+  ISOBMFFArenaTest() {}
+  ~ISOBMFFArenaTest() override {}
+};
+
+class TestObject : public Arena::Object {
+public:
+  TestObject(int value) : value(value) {}
+
+  int value;
+};
+
+TEST_F(ISOBMFFArenaTest, TestChunks) {
+  ISOBMFF::Arena arena(1024);
+  EXPECT_EQ(arena.GetReservedSize(), 0u);
+  EXPECT_EQ(arena.GetAllocatedSize(), 0u);
+
+  // small allocations follow each other in a chunk
+  uint8_t *p1 = static_cast<uint8_t *>(arena.Allocate(100, 4));
+  uint8_t *p2 = static_cast<uint8_t *>(arena.Allocate(100, 4));
+  EXPECT_EQ(p2, p1 + 100);
+  EXPECT_EQ(arena.GetReservedSize(), 1024u);
+  EXPECT_EQ(arena.GetAllocatedSize(), 200u);
+
+  // alignment
+  void *aligned = arena.Allocate(1, 64);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0u);
+
+  // full chunks are replaced
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_NE(arena.Allocate(250, 1), nullptr);
+  }
+  EXPECT_EQ(arena.GetReservedSize(), 2048u);
+
+  // large allocations get their own chunk, and keep the current one
+  uint8_t *current = static_cast<uint8_t *>(arena.Allocate(1, 1));
+  void *large = arena.Allocate(1000, 8);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % 8, 0u);
+  EXPECT_EQ(arena.GetReservedSize(), 2048u + 1008u);
+  EXPECT_EQ(arena.Allocate(1, 1), current + 1);
+  EXPECT_GE(arena.GetReservedSize(), arena.GetAllocatedSize());
+}
+
+TEST_F(ISOBMFFArenaTest, TestAllocator) {
+  std::shared_ptr<ISOBMFF::Arena> arena = ISOBMFF::Arena::Create(1024);
+  ISOBMFF::Arena::Allocator<std::string> allocator(arena.get());
+
+  // allocations keep the arena alive
+  std::shared_ptr<std::string> value = std::allocate_shared<std::string>(
+      allocator, "a string long enough not to be stored in place");
+  ISOBMFF::Arena::Allocator<int> copy(allocator);
+  EXPECT_TRUE(copy == allocator);
+  EXPECT_GT(arena->GetAllocatedSize(), sizeof(std::string));
+  arena = nullptr;
+  EXPECT_EQ(*(value), "a string long enough not to be stored in place");
+  EXPECT_GT(allocator.GetArena()->GetAllocatedSize(), 0u);
+
+  std::shared_ptr<std::string> other =
+      std::allocate_shared<std::string>(copy, "other");
+  value = nullptr;
+  EXPECT_EQ(*(other), "other");
+  other = nullptr;
+
+  ISOBMFF::Arena arena2;
+  EXPECT_TRUE(ISOBMFF::Arena::Allocator<int>(&arena2) != allocator);
+}
+
+TEST_F(ISOBMFFArenaTest, TestObjects) {
+  // chunks of this size are freed with the arena, instead of being cached
+  std::shared_ptr<ISOBMFF::Arena> arena = ISOBMFF::Arena::Create(1024);
+  std::unique_ptr<TestObject> object;
+  std::unique_ptr<TestObject> heap(new TestObject(1));
+  {
+    ISOBMFF::Arena::Scope scope(arena.get());
+    EXPECT_EQ(ISOBMFF::Arena::GetCurrent(), arena.get());
+    object.reset(new TestObject(2));
+    {
+      ISOBMFF::Arena::Scope inner(nullptr);
+      EXPECT_EQ(ISOBMFF::Arena::GetCurrent(), nullptr);
+    }
+    EXPECT_EQ(ISOBMFF::Arena::GetCurrent(), arena.get());
+  }
+  EXPECT_EQ(ISOBMFF::Arena::GetCurrent(), nullptr);
+  EXPECT_GT(arena->GetAllocatedSize(), sizeof(TestObject));
+
+  // objects keep the arena alive
+  arena = nullptr;
+  EXPECT_EQ(object->value, 2);
+  EXPECT_EQ(heap->value, 1);
+  object = nullptr;
+  heap = nullptr;
+
+  // so box contents can be moved out of the arena boxes
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  ISOBMFF::Parser parser;
+  parser.AddOption(ISOBMFF::Parser::Options::ArenaAllocation);
+  ASSERT_FALSE(parser.Parse(path));
+  std::shared_ptr<ISOBMFF::MVHD> mvhd =
+      parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov")->GetTypedBox<
+          ISOBMFF::MVHD>("mvhd");
+  ASSERT_NE(mvhd, nullptr);
+  const uint32_t timescale = mvhd->GetTimescale();
+  ISOBMFF::MVHD moved(std::move(*(mvhd)));
+  mvhd = nullptr;
+  parser = ISOBMFF::Parser();
+
+  // the next arena on this thread would reuse the chunks of a released one
+  parser.AddOption(ISOBMFF::Parser::Options::ArenaAllocation);
+  ASSERT_FALSE(parser.Parse(std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC"));
+  EXPECT_EQ(moved.GetTimescale(), timescale);
+  EXPECT_EQ(moved.GetName(), "mvhd");
+}
+
+TEST_F(ISOBMFFArenaTest, TestChunkCache) {
+  // a new thread starts with an empty cache
+  std::thread thread([]() {
+    void *first;
+    {
+      ISOBMFF::Arena arena;
+      first = arena.Allocate(8, 8);
+      EXPECT_EQ(arena.GetReservedSize(), ISOBMFF::Arena::DefaultChunkSize);
+    }
+
+    // the chunks of destroyed arenas are reused on the same thread
+    ISOBMFF::Arena arena;
+    EXPECT_EQ(arena.Allocate(8, 8), first);
+    EXPECT_EQ(arena.GetReservedSize(), ISOBMFF::Arena::DefaultChunkSize);
+
+    // arenas with other chunk sizes do not use the cache
+    ISOBMFF::Arena small(1024);
+    EXPECT_NE(small.Allocate(8, 8), nullptr);
+    EXPECT_EQ(small.GetReservedSize(), 1024u);
+  });
+  thread.join();
+
+  // chunks go to the cache of the thread destroying the arena
+  std::shared_ptr<ISOBMFF::Arena> arena;
+  void *chunk = nullptr;
+  std::thread creator([&]() {
+    arena = ISOBMFF::Arena::Create();
+    chunk = arena->Allocate(8, 8);
+  });
+  creator.join();
+  std::thread destroyer([&]() {
+    arena = nullptr;
+    ISOBMFF::Arena other;
+    EXPECT_EQ(other.Allocate(8, 8), chunk);
+  });
+  destroyer.join();
+}
+
+} // namespace ISOBMFF
@@ -0,0 +1,444 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+
+#include <ISOBMFF.hpp>                  // for various
+#include <BinaryDataStream.hpp> // for BinaryDataStream
+#include <BinarySubStream.hpp>  // for BinarySubStream
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFBinaryStreamTest : public ::testing::Test {
+public:
+  ISOBMFFBinaryStreamTest() {}
+  ~ISOBMFFBinaryStreamTest() override {}
+};
+
+// a stream implementing only what BinaryStream requires
+class SeekableStream : public ISOBMFF::BinaryStream {
+public:
+  explicit SeekableStream(const std::vector<uint8_t> &data)
+      : data(data), pos(0), owner(std::this_thread::get_id()),
+        foreignCalls(0) {}
+
+  using BinaryStream::Read;
+  using BinaryStream::Seek;
+
+  Error Read(uint8_t *buf, size_t size) override {
+    this->CheckThread();
+    if (size > this->data.size() - this->pos) {
+      return Error(ErrorCode::InsufficientData, "Not enough data");
+    }
+    std::copy_n(this->data.data() + this->pos, size, buf);
+    this->pos += size;
+    return Error();
+  }
+
+  size_t Tell() const override { return this->pos; }
+
+  Error Seek(std::streamoff offset, SeekDirection dir) override {
+    this->CheckThread();
+    std::streamoff base = 0;
+    if (dir == SeekDirection::Current) {
+      base = static_cast<std::streamoff>(this->pos);
+    } else if (dir == SeekDirection::End) {
+      base = static_cast<std::streamoff>(this->data.size());
+    }
+    if (base + offset < 0 ||
+        base + offset > static_cast<std::streamoff>(this->data.size())) {
+      return Error(ErrorCode::InvalidSeekOffset, "Invalid seek offset");
+    }
+    this->pos = static_cast<size_t>(base + offset);
+    return Error();
+  }
+
+  // the cursor is only to be used by the thread owning the stream
+  void CheckThread() {
+    if (std::this_thread::get_id() != this->owner) {
+      this->foreignCalls++;
+    }
+  }
+
+  std::vector<uint8_t> data;
+  size_t pos;
+  std::thread::id owner;
+  std::atomic<size_t> foreignCalls;
+};
+
+TEST_F(ISOBMFFBinaryStreamTest, TestDefaultSize) {
+  SeekableStream stream({0x00, 0x01, 0x02, 0x03, 0x04, 0x05});
+
+  EXPECT_FALSE(stream.Seek(2, ISOBMFF::BinaryStream::SeekDirection::Begin));
+  EXPECT_EQ(stream.Size(), 6u);
+  EXPECT_EQ(stream.Tell(), 2u);
+  EXPECT_EQ(stream.AvailableBytes(), 4u);
+
+  std::vector<uint8_t> rest;
+  EXPECT_FALSE(stream.ReadAllData(rest));
+  EXPECT_EQ(rest, std::vector<uint8_t>({0x02, 0x03, 0x04, 0x05}));
+  EXPECT_FALSE(stream.HasBytesAvailable());
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestDefaultReadAt) {
+  SeekableStream stream({0x00, 0x01, 0x02, 0x03, 0x04, 0x05});
+  uint8_t buf[3] = {0, 0, 0};
+
+  // positional reads restore the cursor
+  EXPECT_FALSE(stream.Seek(1, ISOBMFF::BinaryStream::SeekDirection::Begin));
+  EXPECT_FALSE(stream.ReadAt(3, buf, 3));
+  EXPECT_EQ(buf[0], 0x03);
+  EXPECT_EQ(buf[2], 0x05);
+  EXPECT_EQ(stream.Tell(), 1u);
+  EXPECT_TRUE(stream.ReadAt(4, buf, 3));
+  EXPECT_TRUE(stream.ReadAt(UINT64_MAX, buf, 1));
+  EXPECT_EQ(stream.Tell(), 1u);
+  EXPECT_FALSE(stream.IsReadAtThreadSafe());
+  EXPECT_FALSE(stream.Get(buf, 1, 2));
+  EXPECT_EQ(buf[0], 0x02);
+  EXPECT_EQ(stream.Tell(), 1u);
+  EXPECT_TRUE(stream.Get(buf, 3, 3));
+  EXPECT_EQ(stream.Tell(), 1u);
+
+  // such streams can be parsed, including in parallel
+  std::vector<uint8_t> data;
+  ISOBMFF::BinaryFileStream file(std::string(TEST_MEDIA_DIR) + "/MOV1.MOV");
+  ASSERT_FALSE(file.ReadAllData(data));
+
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(data));
+  std::string dump = parser.GetFile()->ToString();
+
+  SeekableStream seekable(data);
+  ASSERT_FALSE(parser.Parse(seekable));
+  EXPECT_EQ(parser.GetFile()->ToString(), dump);
+
+  SeekableStream parallel(data);
+  parser.AddOption(ISOBMFF::Parser::Options::ParallelDecoding);
+  parser.SetThreadPool(std::make_shared<ISOBMFF::ThreadPool>(4));
+  ASSERT_FALSE(parser.Parse(parallel));
+  EXPECT_EQ(parser.GetFile()->ToString(), dump);
+
+  // their data is read on the calling thread, and only parsed by workers
+  EXPECT_EQ(parallel.foreignCalls, 0u);
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestReadBigEndianArrays) {
+  // odd lengths exercise both the vector and the scalar paths
+  std::vector<uint8_t> buffer;
+  for (size_t i = 0; i < 4 * 37 + 1; i++) {
+    buffer.push_back(static_cast<uint8_t>(i * 7 + 3));
+  }
+
+  std::vector<uint32_t> expected32;
+  ISOBMFF::BinaryDataStream stream32(buffer);
+  for (size_t i = 0; i < 37; i++) {
+    uint32_t value;
+    EXPECT_FALSE(stream32.ReadBigEndianUInt32(value));
+    expected32.push_back(value);
+  }
+
+  std::vector<uint32_t> values32(37);
+  ISOBMFF::BinaryDataStream bulk32(buffer);
+  EXPECT_FALSE(bulk32.ReadBigEndianUInt32Array(values32.data(), 37));
+  EXPECT_EQ(values32, expected32);
+  EXPECT_EQ(bulk32.Tell(), 4u * 37);
+
+  std::vector<uint16_t> expected16;
+  ISOBMFF::BinaryDataStream stream16(buffer);
+  for (size_t i = 0; i < 73; i++) {
+    uint16_t value;
+    EXPECT_FALSE(stream16.ReadBigEndianUInt16(value));
+    expected16.push_back(value);
+  }
+
+  std::vector<uint16_t> values16(73);
+  ISOBMFF::BinaryDataStream bulk16(buffer);
+  EXPECT_FALSE(bulk16.ReadBigEndianUInt16Array(values16.data(), 73));
+  EXPECT_EQ(values16, expected16);
+
+  std::vector<uint64_t> expected64;
+  ISOBMFF::BinaryDataStream stream64(buffer);
+  for (size_t i = 0; i < 18; i++) {
+    uint64_t value;
+    EXPECT_FALSE(stream64.ReadBigEndianUInt64(value));
+    expected64.push_back(value);
+  }
+
+  std::vector<uint64_t> values64(18);
+  ISOBMFF::BinaryDataStream bulk64(buffer);
+  EXPECT_FALSE(bulk64.ReadBigEndianUInt64Array(values64.data(), 18));
+  EXPECT_EQ(values64, expected64);
+  EXPECT_TRUE(bulk64.ReadBigEndianUInt64Array(values64.data(), 1));
+
+  // reads past the end fail without consuming anything
+  ISOBMFF::BinaryDataStream truncated(buffer);
+  EXPECT_TRUE(truncated.ReadBigEndianUInt32Array(values32.data(), 38));
+  EXPECT_TRUE(truncated.ReadBigEndianUInt32Array(values32.data(), SIZE_MAX));
+  EXPECT_EQ(truncated.Tell(), 0u);
+  EXPECT_FALSE(truncated.ReadBigEndianUInt32Array(values32.data(), 0));
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestBorrowedData) {
+  std::vector<uint8_t> buffer = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05};
+
+  // the stream reads a window of the caller's bytes
+  ISOBMFF::BinaryDataStream stream(buffer.data() + 1, 4);
+  uint8_t u8 = 0;
+  uint16_t u16 = 0;
+  EXPECT_EQ(stream.Size(), 4u);
+  EXPECT_FALSE(stream.ReadUInt8(u8));
+  EXPECT_EQ(u8, 0x01);
+  EXPECT_FALSE(stream.ReadBigEndianUInt16(u16));
+  EXPECT_EQ(u16, 0x0203);
+  EXPECT_EQ(stream.Tell(), 3u);
+
+  uint8_t bytes[2] = {0, 0};
+  EXPECT_TRUE(stream.Read(bytes, 2));
+  EXPECT_FALSE(stream.ReadAt(2, bytes, 2));
+  EXPECT_EQ(bytes[0], 0x03);
+  EXPECT_EQ(bytes[1], 0x04);
+  EXPECT_TRUE(stream.ReadAt(3, bytes, 2));
+
+  // the bytes are not copied, by the stream or its copies
+  ISOBMFF::BinaryDataStream copy(stream);
+  EXPECT_EQ(copy.Tell(), stream.Tell());
+  buffer[4] = 0xff;
+  EXPECT_FALSE(stream.ReadUInt8(u8));
+  EXPECT_EQ(u8, 0xff);
+  EXPECT_FALSE(copy.ReadUInt8(u8));
+  EXPECT_EQ(u8, 0xff);
+  EXPECT_FALSE(stream.HasBytesAvailable());
+
+  std::vector<uint8_t> all;
+  EXPECT_FALSE(copy.Seek(0, ISOBMFF::BinaryStream::SeekDirection::Begin));
+  EXPECT_FALSE(copy.ReadAllData(all));
+  EXPECT_EQ(all, std::vector<uint8_t>({0x01, 0x02, 0x03, 0xff}));
+
+  // empty data
+  ISOBMFF::BinaryDataStream empty(nullptr, 0);
+  EXPECT_EQ(empty.Size(), 0u);
+  EXPECT_FALSE(empty.HasBytesAvailable());
+  EXPECT_TRUE(empty.ReadAt(0, bytes, 1));
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestSubStream) {
+  std::vector<uint8_t> buffer;
+  for (size_t i = 0; i < 32; i++) {
+    buffer.push_back(static_cast<uint8_t>(i));
+  }
+  ISOBMFF::BinaryDataStream source(buffer);
+  ISOBMFF::BinarySubStream window(source, 8, 16);
+  EXPECT_EQ(window.Size(), 16u);
+  EXPECT_EQ(window.Tell(), 0u);
+
+  // reads stop at the window end, without consuming anything
+  uint8_t bytes[17];
+  EXPECT_FALSE(window.Read(bytes, 4));
+  EXPECT_EQ(bytes[0], 8);
+  EXPECT_EQ(bytes[3], 11);
+  EXPECT_TRUE(window.Read(bytes, 13));
+  EXPECT_EQ(window.Tell(), 4u);
+  EXPECT_FALSE(window.Read(bytes, 12));
+  EXPECT_EQ(bytes[11], 23);
+  EXPECT_FALSE(window.HasBytesAvailable());
+  EXPECT_TRUE(window.Read(bytes, 1));
+
+  // seeks, relative to each direction
+  using Direction = ISOBMFF::BinaryStream::SeekDirection;
+  EXPECT_FALSE(window.Seek(2, Direction::Begin));
+  EXPECT_EQ(window.Tell(), 2u);
+  EXPECT_FALSE(window.Seek(3, Direction::Current));
+  EXPECT_EQ(window.Tell(), 5u);
+  EXPECT_FALSE(window.Seek(-5, Direction::Current));
+  EXPECT_EQ(window.Tell(), 0u);
+  EXPECT_FALSE(window.Seek(-4, Direction::End));
+  EXPECT_EQ(window.Tell(), 12u);
+  EXPECT_FALSE(window.Seek(0, Direction::End));
+  EXPECT_EQ(window.Tell(), 16u);
+
+  // out of range seeks fail, and keep the position
+  EXPECT_FALSE(window.Seek(6, Direction::Begin));
+  EXPECT_TRUE(window.Seek(-1, Direction::Begin));
+  EXPECT_TRUE(window.Seek(17, Direction::Begin));
+  EXPECT_TRUE(window.Seek(-7, Direction::Current));
+  EXPECT_TRUE(window.Seek(11, Direction::Current));
+  EXPECT_TRUE(window.Seek(1, Direction::End));
+  EXPECT_TRUE(window.Seek(-17, Direction::End));
+  EXPECT_EQ(window.Tell(), 6u);
+
+  // windows over windows read from the outermost source
+  ISOBMFF::BinarySubStream child(window, 4, 8);
+  ISOBMFF::BinarySubStream grandchild(child, 2, 4);
+  EXPECT_EQ(&(child.GetSource()), &source);
+  EXPECT_EQ(child.GetOffset(), 12u);
+  EXPECT_EQ(child.GetLength(), 8u);
+  EXPECT_EQ(&(grandchild.GetSource()), &source);
+  EXPECT_EQ(grandchild.GetOffset(), 14u);
+  EXPECT_EQ(grandchild.GetLength(), 4u);
+  EXPECT_FALSE(grandchild.Read(bytes, 4));
+  EXPECT_EQ(bytes[0], 14);
+  EXPECT_EQ(bytes[3], 17);
+  EXPECT_TRUE(grandchild.Read(bytes, 1));
+  EXPECT_EQ(grandchild.GetBytes(), source.GetBytes() + 14);
+  EXPECT_EQ(grandchild.GetBytes()[0], 14);
+
+  // parent and child windows share the source cursor, and each keeps
+  // its own position
+  EXPECT_FALSE(window.Seek(4, Direction::Begin));
+  EXPECT_FALSE(window.Read(bytes, 2));
+  EXPECT_EQ(bytes[0], 12);
+  EXPECT_FALSE(child.Read(bytes, 2));
+  EXPECT_EQ(bytes[0], 12);
+  EXPECT_FALSE(window.Read(bytes, 2));
+  EXPECT_EQ(bytes[0], 14);
+  EXPECT_FALSE(child.Read(bytes, 2));
+  EXPECT_EQ(bytes[0], 14);
+  EXPECT_FALSE(source.Seek(0, Direction::Begin));
+  EXPECT_FALSE(child.Read(bytes, 1));
+  EXPECT_EQ(bytes[0], 16);
+  EXPECT_EQ(window.Tell(), 8u);
+  EXPECT_EQ(child.Tell(), 5u);
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestTruncatedSampleTable) {
+  // stts claiming more entries than the box holds
+  const std::vector<uint8_t> buffer = {
+      0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+      0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x0b, 0xb8,
+  };
+
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  std::shared_ptr<ISOBMFF::Box> box = parser.CreateBox("stts");
+  ASSERT_NE(box, nullptr);
+  EXPECT_TRUE(box->ReadData(parser, stream));
+
+  auto stts = std::dynamic_pointer_cast<ISOBMFF::STTS>(box);
+  ASSERT_NE(stts, nullptr);
+  EXPECT_EQ(stts->GetEntryCount(), 0u);
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestMappedFileStream) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC";
+
+  ISOBMFF::BinaryMappedFileStream mapped(path);
+  ASSERT_TRUE(mapped.IsMapped());
+
+  ISOBMFF::BinaryFileStream regular(path);
+  std::vector<uint8_t> mappedData;
+  std::vector<uint8_t> regularData;
+  EXPECT_FALSE(mapped.ReadAllData(mappedData));
+  EXPECT_FALSE(regular.ReadAllData(regularData));
+  EXPECT_EQ(mappedData, regularData);
+
+  // both backends must produce the same tree
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+  std::string mappedDump = parser.GetFile()->ToString();
+
+  parser.AddOption(ISOBMFF::Parser::Options::DoNotMapFiles);
+  ASSERT_FALSE(parser.Parse(path));
+  EXPECT_EQ(parser.GetFile()->ToString(), mappedDump);
+
+  // missing files are not mapped, and still fail to parse
+  ISOBMFF::BinaryMappedFileStream missing(path + ".missing");
+  EXPECT_FALSE(missing.IsMapped());
+  parser.RemoveOption(ISOBMFF::Parser::Options::DoNotMapFiles);
+  EXPECT_TRUE(parser.Parse(path + ".missing"));
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestBufferedFileStream) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC";
+
+  ISOBMFF::BinaryFileStream unbuffered(path, 0);
+  ISOBMFF::BinaryFileStream buffered(path, 4096);
+  EXPECT_EQ(unbuffered.GetBufferSize(), 0u);
+  EXPECT_EQ(buffered.GetBufferSize(), 4096u);
+
+  // both streams must produce the same tree
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(unbuffered));
+  std::string unbufferedDump = parser.GetFile()->ToString();
+  ASSERT_FALSE(parser.Parse(buffered));
+  EXPECT_EQ(parser.GetFile()->ToString(), unbufferedDump);
+
+  // the read-ahead buffer serves most small reads
+  EXPECT_GT(buffered.GetReadCount(), 0u);
+  EXPECT_LT(buffered.GetReadCount() * 10, unbuffered.GetReadCount());
+
+  // seeking backward and forward within the buffer does not re-read
+  ISOBMFF::BinaryFileStream stream(path, 4096);
+  uint32_t size;
+  uint32_t type;
+  EXPECT_FALSE(stream.ReadBigEndianUInt32(size));
+  EXPECT_FALSE(stream.ReadBigEndianUInt32(type));
+  EXPECT_EQ(stream.GetReadCount(), 1u);
+  EXPECT_EQ(stream.GetBytesRead(), 4096u);
+  EXPECT_FALSE(stream.Seek(0, ISOBMFF::BinaryStream::SeekDirection::Begin));
+  uint32_t again;
+  EXPECT_FALSE(stream.ReadBigEndianUInt32(again));
+  EXPECT_EQ(again, size);
+  EXPECT_FALSE(
+      stream.Seek(1024, ISOBMFF::BinaryStream::SeekDirection::Current));
+  EXPECT_FALSE(stream.ReadBigEndianUInt32(again));
+  EXPECT_EQ(stream.GetReadCount(), 1u);
+}
+
+TEST_F(ISOBMFFBinaryStreamTest, TestReadAt) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+
+  ISOBMFF::BinaryFileStream file(path);
+  ISOBMFF::BinaryMappedFileStream mapped(path);
+  std::vector<uint8_t> data;
+  ASSERT_FALSE(file.ReadAllData(data));
+  ISOBMFF::BinaryDataStream memory(data.data(), data.size());
+  ISOBMFF::BinarySubStream window(memory, 16, 64);
+
+  // positional reads do not move the cursor
+  uint8_t buf[32];
+  EXPECT_FALSE(memory.Seek(8, ISOBMFF::BinaryStream::SeekDirection::Begin));
+  EXPECT_FALSE(memory.ReadAt(100, buf, sizeof(buf)));
+  EXPECT_EQ(memory.Tell(), 8u);
+  EXPECT_TRUE(std::equal(buf, buf + sizeof(buf), data.begin() + 100));
+
+  EXPECT_FALSE(mapped.ReadAt(100, buf, sizeof(buf)));
+  EXPECT_TRUE(std::equal(buf, buf + sizeof(buf), data.begin() + 100));
+
+  EXPECT_FALSE(window.ReadAt(32, buf, sizeof(buf)));
+  EXPECT_TRUE(std::equal(buf, buf + sizeof(buf), data.begin() + 48));
+  EXPECT_TRUE(window.ReadAt(33, buf, sizeof(buf)));
+
+  EXPECT_TRUE(file.ReadAt(data.size() - 8, buf, 16));
+  EXPECT_TRUE(memory.ReadAt(data.size() + 1, buf, 0));
+
+  // concurrent reads from a single file stream
+  std::vector<std::thread> threads;
+  std::atomic<int> mismatches(0);
+  for (size_t t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      uint8_t chunk[61];
+      for (size_t offset = t; offset + sizeof(chunk) <= data.size();
+           offset += 97) {
+        if (file.ReadAt(offset, chunk, sizeof(chunk)) ||
+            std::equal(chunk, chunk + sizeof(chunk),
+                       data.data() + offset) == false) {
+          mismatches++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+} // namespace ISOBMFF
@@ -0,0 +1,201 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+#include <BoxVisitor.hpp> // for BoxVisitor
+#include <ISOBMFF.hpp>    // for various
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFBoxVisitorTest : public ::testing::Test {
+public:
+  ISOBMFFBoxVisitorTest() {}
+  ~ISOBMFFBoxVisitorTest() override {}
+};
+
+// records the events, and skips or stops on the given paths
+class RecordingVisitor : public BoxVisitor {
+public:
+  Action EnterBox(const Parser::BoxMapEntry &entry) override {
+    entered.push_back(entry);
+    depth++;
+    if (entry.path == skip) {
+      depth--;
+      return Action::Skip;
+    }
+    return (entry.path == stop) ? Action::Stop : Action::Continue;
+  }
+
+  Action VisitBox(const std::shared_ptr<Box> &box) override {
+    visited.push_back(box);
+    return Action::Continue;
+  }
+
+  Action ExitBox(const Parser::BoxMapEntry &entry) override {
+    exited.push_back(entry);
+    depth--;
+    return Action::Continue;
+  }
+
+  std::string skip;
+  std::string stop;
+  int depth = 0;
+  std::vector<Parser::BoxMapEntry> entered;
+  std::vector<Parser::BoxMapEntry> exited;
+  std::vector<std::shared_ptr<Box> > visited;
+};
+
+// keeps the sample description of the first video track, and stops
+class VideoSampleDescriptionVisitor : public BoxVisitor {
+public:
+  Action EnterBox(const Parser::BoxMapEntry &entry) override {
+    count++;
+    if (entry.path == "moov/trak") {
+      video = false;
+    }
+    return Action::Continue;
+  }
+
+  Action VisitBox(const std::shared_ptr<Box> &box) override {
+    std::shared_ptr<HDLR> hdlr = std::dynamic_pointer_cast<HDLR>(box);
+    if (hdlr != nullptr && hdlr->GetHandlerType() == "vide") {
+      video = true;
+    }
+    if (video && box->GetName() == "stsd") {
+      stsd = std::dynamic_pointer_cast<STSD>(box);
+      return Action::Stop;
+    }
+    return Action::Continue;
+  }
+
+  bool video = false;
+  size_t count = 0;
+  std::shared_ptr<STSD> stsd;
+};
+
+TEST_F(ISOBMFFBoxVisitorTest, TestVisitEvents) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  ISOBMFF::Parser parser;
+  std::vector<ISOBMFF::Parser::BoxMapEntry> boxes;
+  ASSERT_FALSE(parser.Scan(path, boxes));
+
+  // boxes are entered like they are scanned, and all of them are exited
+  RecordingVisitor visitor;
+  ASSERT_FALSE(parser.Parse(path, visitor));
+  ASSERT_EQ(visitor.entered.size(), boxes.size());
+  for (size_t i = 0; i < boxes.size(); i++) {
+    EXPECT_EQ(visitor.entered[i].path, boxes[i].path);
+    EXPECT_EQ(visitor.entered[i].offset, boxes[i].offset);
+    EXPECT_EQ(visitor.entered[i].size, boxes[i].size);
+  }
+  EXPECT_EQ(visitor.exited.size(), boxes.size());
+  EXPECT_EQ(visitor.depth, 0);
+  EXPECT_EQ(parser.GetFile(), nullptr);
+
+  // the decoded boxes are the ones of the parsed tree
+  ASSERT_FALSE(parser.Parse(path));
+  std::shared_ptr<ISOBMFF::ContainerBox> stbl =
+      parser.GetFile()
+          ->GetTypedBox<ISOBMFF::ContainerBox>("moov")
+          ->GetTypedBox<ISOBMFF::ContainerBox>("trak")
+          ->GetTypedBox<ISOBMFF::ContainerBox>("mdia")
+          ->GetTypedBox<ISOBMFF::ContainerBox>("minf")
+          ->GetTypedBox<ISOBMFF::ContainerBox>("stbl");
+  ASSERT_NE(stbl, nullptr);
+  std::shared_ptr<ISOBMFF::STTS> stts =
+      stbl->GetTypedBox<ISOBMFF::STTS>("stts");
+  ASSERT_NE(stts, nullptr);
+  std::shared_ptr<ISOBMFF::Box> visited;
+  for (const auto &box : visitor.visited) {
+    if (box->GetOffset() == stts->GetOffset()) {
+      visited = box;
+    }
+  }
+  ASSERT_NE(visited, nullptr);
+  EXPECT_NE(std::dynamic_pointer_cast<ISOBMFF::STTS>(visited), nullptr);
+  EXPECT_EQ(visited->ToString(), stts->ToString());
+  EXPECT_NE(parser.GetFile(), nullptr);
+}
+
+TEST_F(ISOBMFFBoxVisitorTest, TestVisitSkip) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  ISOBMFF::Parser parser;
+
+  // skipped boxes are neither descended into nor exited
+  RecordingVisitor visitor;
+  visitor.skip = "moov/trak";
+  ASSERT_FALSE(parser.Parse(path, visitor));
+  EXPECT_EQ(visitor.depth, 0);
+  size_t traks = 0;
+  for (const auto &entry : visitor.entered) {
+    EXPECT_NE(entry.path.compare(0, 10, "moov/trak/"), 0);
+    traks += (entry.path == "moov/trak") ? 1u : 0u;
+  }
+  EXPECT_EQ(traks, 4);
+  for (const auto &entry : visitor.exited) {
+    EXPECT_NE(entry.path, "moov/trak");
+  }
+  EXPECT_EQ(visitor.entered.size(), visitor.exited.size() + traks);
+
+  // box path filters apply
+  RecordingVisitor filtered;
+  ASSERT_FALSE(parser.DenyBoxPath("moov/trak"));
+  ASSERT_FALSE(parser.Parse(path, filtered));
+  EXPECT_EQ(filtered.entered.size(), visitor.exited.size());
+  EXPECT_EQ(filtered.depth, 0);
+}
+
+TEST_F(ISOBMFFBoxVisitorTest, TestVisitStop) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  ISOBMFF::Parser parser;
+  std::vector<ISOBMFF::Parser::BoxMapEntry> boxes;
+  ASSERT_FALSE(parser.Scan(path, boxes));
+
+  // stopping is not an error
+  RecordingVisitor visitor;
+  visitor.stop = "moov";
+  ASSERT_FALSE(parser.Parse(path, visitor));
+  ASSERT_FALSE(visitor.entered.empty());
+  EXPECT_EQ(visitor.entered.back().path, "moov");
+  EXPECT_TRUE(visitor.visited.size() < visitor.entered.size());
+
+  // parsing stops with the first video sample description
+  VideoSampleDescriptionVisitor video;
+  ASSERT_FALSE(parser.Parse(path, video));
+  ASSERT_NE(video.stsd, nullptr);
+  EXPECT_LT(video.count, boxes.size());
+  size_t i = 0;
+  while (i < boxes.size() && boxes[i].offset != video.stsd->GetOffset()) {
+    i++;
+  }
+  ASSERT_LT(i, boxes.size());
+  EXPECT_EQ(boxes[i].path, "moov/trak/mdia/minf/stbl/stsd");
+  EXPECT_EQ(video.count, i + 1);
+  EXPECT_NE(video.stsd->GetBox("hvc1"), nullptr);
+
+  // data and streams can be visited too
+  std::vector<uint8_t> data;
+  {
+    ISOBMFF::BinaryFileStream stream(path);
+    ASSERT_FALSE(stream.Read(data, stream.Size()));
+  }
+  VideoSampleDescriptionVisitor fromData;
+  ASSERT_FALSE(parser.Parse(data.data(), data.size(), fromData));
+  ASSERT_NE(fromData.stsd, nullptr);
+  EXPECT_EQ(fromData.stsd->GetOffset(), video.stsd->GetOffset());
+  EXPECT_EQ(fromData.stsd->ToString(), video.stsd->ToString());
+
+  // not an ISO media file
+  const std::vector<uint8_t> invalid = {0x00, 0x00, 0x00, 0x08,
+                                        'a',  'b',  'c',  'd'};
+  RecordingVisitor none;
+  EXPECT_TRUE(parser.Parse(invalid.data(), invalid.size(), none));
+  EXPECT_TRUE(none.entered.empty());
+}
+
+}  // namespace ISOBMFF
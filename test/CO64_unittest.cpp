@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+
+#include <ISOBMFF.hpp>                  // for various
+#include <BinaryDataStream.hpp> // for BinaryDataStream
+#include <Parser.hpp>           // for Parser
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFCO64Test : public ::testing::Test {
+public:
+  ISOBMFFCO64Test() {}
+  ~ISOBMFFCO64Test() override {}
+};
+
+TEST_F(ISOBMFFCO64Test, TestCO64Parser) {
+  // fuzzer::conv: data
+  const std::vector<uint8_t> &buffer = {
+      // co64 size: 36 bytes
+      // 0x00, 0x00, 0x00, 0x24,
+      // co64
+      // 0x63, 0x6f, 0x36, 0x34,
+      // co64 content:
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24,
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x2c, 0x73,
+      0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0
+  };
+
+  // fuzzer::conv: begin
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  std::shared_ptr<ISOBMFF::Box> box = parser.CreateBox("co64");
+
+  ISOBMFF::Error error;
+  if (box != nullptr) {
+    error = box->ReadData(parser, stream);
+  }
+  if (error) {
+    fprintf(stderr, "Parse error: %s\n", error.GetMessage().c_str());
+  }
+  // fuzzer::conv: end
+
+  // Validate CO64 box
+  auto co64 = std::dynamic_pointer_cast<ISOBMFF::CO64>(box);
+  ASSERT_NE(co64, nullptr) << "Failed to cast to CO64";
+
+  // Validate chunk offsets
+  EXPECT_EQ(co64->GetEntryCount(), 3);
+  EXPECT_EQ(co64->GetChunkOffset(0), 36);
+  EXPECT_EQ(co64->GetChunkOffset(1), 0x100012c73ull);
+  EXPECT_EQ(co64->GetChunkOffset(2), 0x123456789abcdef0ull);
+}
+
+TEST_F(ISOBMFFCO64Test, TestTruncated) {
+  // tables larger than the box
+  const std::vector<uint8_t> &buffer = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24,
+      0x00, 0x00, 0x00, 0x01
+  };
+
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  ISOBMFF::CO64 co64;
+  EXPECT_TRUE(co64.ReadData(parser, stream));
+}
+} // namespace ISOBMFF
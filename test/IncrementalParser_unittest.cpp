@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+#include <ISOBMFF.hpp>           // for various
+#include <IncrementalParser.hpp> // for IncrementalParser
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFIncrementalParserTest : public ::testing::Test {
+public:
+  ISOBMFFIncrementalParserTest() {}
+  ~ISOBMFFIncrementalParserTest() override {}
+};
+
+static std::vector<uint8_t> ReadFile(const std::string &path) {
+  std::vector<uint8_t> data;
+  ISOBMFF::BinaryFileStream stream(path);
+  EXPECT_FALSE(stream.Read(data, stream.Size()));
+  return data;
+}
+
+// checks that two trees have the same boxes, at the same offsets
+static void ExpectSameBoxes(const std::shared_ptr<Box> &expected,
+                            const std::shared_ptr<Box> &actual) {
+  ASSERT_NE(actual, nullptr);
+  EXPECT_EQ(actual->GetName(), expected->GetName());
+  EXPECT_EQ(actual->GetOffset(), expected->GetOffset());
+  EXPECT_EQ(actual->GetSize(), expected->GetSize());
+  Container *e = dynamic_cast<Container *>(expected.get());
+  Container *a = dynamic_cast<Container *>(actual.get());
+  if (e == nullptr) {
+    EXPECT_EQ(a, nullptr);
+    return;
+  }
+  ASSERT_NE(a, nullptr);
+  std::vector<std::shared_ptr<Box> > eb = e->GetBoxes();
+  std::vector<std::shared_ptr<Box> > ab = a->GetBoxes();
+  ASSERT_EQ(ab.size(), eb.size());
+  for (size_t i = 0; i < eb.size(); i++) {
+    ExpectSameBoxes(eb[i], ab[i]);
+  }
+}
+
+TEST_F(ISOBMFFIncrementalParserTest, TestChunks) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  const std::vector<uint8_t> data = ReadFile(path);
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+
+  // the result does not depend on how the data is split
+  for (size_t chunk : {size_t(1), size_t(7), size_t(4096), data.size()}) {
+    ISOBMFF::IncrementalParser incremental;
+    for (size_t i = 0; i < data.size(); i += chunk) {
+      ASSERT_FALSE(incremental.Append(
+          data.data() + i, std::min(chunk, data.size() - i)));
+    }
+    ASSERT_FALSE(incremental.Finish());
+    EXPECT_EQ(incremental.GetBytesAppended(), data.size());
+    EXPECT_EQ(incremental.GetPendingBytes(), 0);
+    ASSERT_NE(incremental.GetFile(), nullptr);
+    EXPECT_EQ(incremental.GetFile()->ToString(),
+              parser.GetFile()->ToString());
+    ExpectSameBoxes(parser.GetFile(), incremental.GetFile());
+  }
+}
+
+TEST_F(ISOBMFFIncrementalParserTest, TestStream) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC";
+  const std::vector<uint8_t> data = ReadFile(path);
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+
+  // streams are read forward only, to their end
+  std::ifstream file(path, std::ios::binary);
+  ISOBMFF::IncrementalParser incremental;
+  ASSERT_FALSE(incremental.Append(file));
+  ASSERT_FALSE(incremental.Finish());
+  EXPECT_EQ(incremental.GetBytesAppended(), data.size());
+  EXPECT_EQ(incremental.GetFile()->ToString(), parser.GetFile()->ToString());
+
+  // a truncated stream
+  std::stringstream truncated(
+      std::string(reinterpret_cast<const char *>(data.data()), 1000));
+  ISOBMFF::IncrementalParser other;
+  ASSERT_FALSE(other.Append(truncated));
+  EXPECT_EQ(other.GetBytesAppended(), 1000);
+  EXPECT_TRUE(other.Finish());
+}
+
+TEST_F(ISOBMFFIncrementalParserTest, TestGrowingFile) {
+  const std::vector<uint8_t> data =
+      ReadFile(std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC");
+  ISOBMFF::IncrementalParser incremental;
+  std::vector<std::string> handled;
+  incremental.SetBoxHandler([&](const std::shared_ptr<Box> &box) {
+    handled.push_back(box->GetName());
+  });
+
+  // boxes are reported as soon as they are complete
+  ASSERT_FALSE(incremental.Append(data.data(), 20));
+  EXPECT_TRUE(handled.empty());
+  EXPECT_EQ(incremental.GetFile(), nullptr);
+  EXPECT_EQ(incremental.GetPendingBytes(), 20);
+  ASSERT_FALSE(incremental.Append(data.data() + 20, 4000 - 20));
+  ASSERT_EQ(handled.size(), 2);
+  EXPECT_EQ(handled[0], "ftyp");
+  EXPECT_EQ(handled[1], "meta");
+  EXPECT_NE(incremental.GetFile()->GetTypedBox<ISOBMFF::META>("meta"),
+            nullptr);
+
+  // mdat data is not kept
+  EXPECT_EQ(incremental.GetPendingBytes(), 0);
+  ASSERT_FALSE(incremental.Append(data.data() + 4000, data.size() - 4000));
+  ASSERT_EQ(handled.size(), 3);
+  EXPECT_EQ(handled[2], "mdat");
+  EXPECT_FALSE(incremental.Finish());
+
+  // truncated boxes are errors, once all the data was appended
+  incremental.Reset();
+  ASSERT_FALSE(incremental.Append(data.data(), 100));
+  ASSERT_NE(incremental.GetFile(), nullptr);
+  EXPECT_EQ(incremental.GetFile()->GetBoxes().size(), 1);
+  EXPECT_TRUE(incremental.Finish());
+  EXPECT_TRUE(incremental.Append(data.data() + 100, 100));
+}
+
+TEST_F(ISOBMFFIncrementalParserTest, TestBoxSizes) {
+  // a size 0 box extends to the end, and 64-bit sizes are supported
+  const std::vector<uint8_t> buffer = {
+      0x00, 0x00, 0x00, 0x10, 'f',  't',  'y',  'p',  'h',  'e',
+      'i',  'c',  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+      'f',  'r',  'e',  'e',  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x12, 0xaa, 0xbb, 0x00, 0x00, 0x00, 0x00, 'm',  'd',
+      'a',  't',  0x01, 0x02, 0x03, 0x04, 0x05};
+  ISOBMFF::IncrementalParser incremental;
+  for (uint8_t byte : buffer) {
+    ASSERT_FALSE(incremental.Append(&byte, 1));
+  }
+  EXPECT_EQ(incremental.GetFile()->GetBoxes().size(), 2);
+  ASSERT_FALSE(incremental.Finish());
+  std::vector<std::shared_ptr<Box> > boxes =
+      incremental.GetFile()->GetBoxes();
+  ASSERT_EQ(boxes.size(), 3);
+  EXPECT_EQ(boxes[1]->GetName(), "free");
+  EXPECT_EQ(boxes[1]->GetOffset(), 16);
+  EXPECT_EQ(boxes[1]->GetHeaderSize(), 16);
+  EXPECT_EQ(boxes[1]->GetData(), std::vector<uint8_t>({0xaa, 0xbb}));
+  EXPECT_EQ(boxes[2]->GetName(), "mdat");
+  EXPECT_EQ(boxes[2]->GetOffset(), 34);
+  EXPECT_EQ(boxes[2]->GetSize(), 13);
+
+  // not an ISO media file
+  const std::vector<uint8_t> invalid = {0x00, 0x00, 0x00, 0x08,
+                                        'a',  'b',  'c',  'd'};
+  ISOBMFF::IncrementalParser other;
+  EXPECT_TRUE(other.Append(invalid));
+  EXPECT_EQ(other.GetFile(), nullptr);
+}
+
+}  // namespace ISOBMFF
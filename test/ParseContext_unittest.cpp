@@ -0,0 +1,239 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+#include <ISOBMFF.hpp>      // for various
+#include <ParseContext.hpp> // for ParseContext
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFParseContextTest : public ::testing::Test {
+public:
+  ISOBMFFParseContextTest() {}
+  ~ISOBMFFParseContextTest() override {}
+};
+
+static std::mutex parentsMutex;
+
+// records the boxes it is found in, while it is read
+class ParentRecordingBox : public Box {
+public:
+  ParentRecordingBox(std::vector<std::string> &parents)
+      : Box("tkhd"), _parents(parents) {}
+
+  Error ReadData(Parser &parser, BinaryStream &stream) override {
+    const ParseContext &context = parser.GetContext();
+    if (context.GetBox() == this && context.GetParent() != nullptr) {
+      std::lock_guard<std::mutex> lock(parentsMutex);
+      _parents.push_back(context.GetParent()->GetName());
+    }
+    return Box::ReadData(parser, stream);
+  }
+
+private:
+  std::vector<std::string> &_parents;
+};
+
+static std::shared_ptr<SingleItemTypeReferenceBox>
+GetReference(const std::shared_ptr<File> &file) {
+  std::shared_ptr<IREF> iref =
+      file->GetTypedBox<META>("meta")->GetTypedBox<IREF>("iref");
+  if (iref == nullptr || iref->GetBoxes().empty()) {
+    return nullptr;
+  }
+  std::shared_ptr<Box> box = iref->GetBoxes()[0];
+  if (box->Load()) {
+    return nullptr;
+  }
+  return std::dynamic_pointer_cast<SingleItemTypeReferenceBox>(box);
+}
+
+TEST_F(ISOBMFFParseContextTest, TestStack) {
+  ISOBMFF::ParseContext context;
+  ISOBMFF::ContainerBox moov("moov");
+  ISOBMFF::ContainerBox trak("trak");
+  ISOBMFF::IREF iref;
+  ISOBMFF::Box tkhd("tkhd");
+
+  EXPECT_EQ(context.GetDepth(), 0);
+  EXPECT_EQ(context.GetBox(), nullptr);
+  EXPECT_EQ(context.GetParent(), nullptr);
+
+  // the innermost box is at level 0
+  context.PushBox(moov);
+  context.PushBox(iref);
+  context.PushBox(trak);
+  context.PushBox(tkhd);
+  EXPECT_EQ(context.GetDepth(), 4);
+  EXPECT_EQ(context.GetBox(), &tkhd);
+  EXPECT_EQ(context.GetParent(), &trak);
+  EXPECT_EQ(context.GetBox(3), &moov);
+  EXPECT_EQ(context.GetBox(4), nullptr);
+  EXPECT_EQ(context.FindBox<ISOBMFF::IREF>(), &iref);
+  EXPECT_EQ(context.FindBox<ISOBMFF::ContainerBox>(), &trak);
+  EXPECT_EQ(context.FindBox<ISOBMFF::STTS>(), nullptr);
+
+  // exposed boxes are exposed until they are popped
+  EXPECT_FALSE(context.HasExposedBoxes());
+  context.PopBox();
+  context.PopBox();
+  context.ExposeBox();
+  context.ExposeBox();
+  EXPECT_TRUE(context.HasExposedBoxes());
+  context.PushBox(trak);
+  EXPECT_TRUE(context.HasExposedBoxes());
+
+  // copies have the same stack
+  ISOBMFF::ParseContext copy(context);
+  EXPECT_EQ(copy.GetDepth(), 3);
+  EXPECT_EQ(copy.GetParent(), &iref);
+  EXPECT_TRUE(copy.HasExposedBoxes());
+
+  context.PopBox();
+  context.PopBox();
+  EXPECT_FALSE(context.HasExposedBoxes());
+  context.PopBox();
+  context.PopBox();
+  EXPECT_EQ(context.GetDepth(), 0);
+  EXPECT_EQ(copy.GetDepth(), 3);
+
+  // scratch memory lasts until the context is reset
+  void *p = context.GetScratch().Allocate(100, 8);
+  EXPECT_NE(p, nullptr);
+  EXPECT_EQ(context.GetScratch().GetAllocatedSize(), 100);
+  EXPECT_EQ(copy.GetScratch().GetAllocatedSize(), 0);
+  copy.Reset();
+  EXPECT_EQ(copy.GetDepth(), 0);
+  EXPECT_FALSE(copy.HasExposedBoxes());
+  context.Reset();
+  EXPECT_EQ(context.GetScratch().GetAllocatedSize(), 0);
+}
+
+TEST_F(ISOBMFFParseContextTest, TestInfo) {
+  ISOBMFF::ParseContext context;
+  int value = 0;
+  EXPECT_FALSE(context.HasInfo());
+  EXPECT_EQ(context.GetInfo("key"), nullptr);
+
+  context.SetInfo("key", &value);
+  EXPECT_TRUE(context.HasInfo());
+  EXPECT_EQ(context.GetInfo("key"), &value);
+  EXPECT_EQ(context.GetInfo("other"), nullptr);
+
+  // info values are copied, and kept when the stack is reset
+  ISOBMFF::ParseContext copy(context);
+  copy.Reset();
+  EXPECT_EQ(copy.GetInfo("key"), &value);
+  context.SetInfo("key", nullptr);
+  EXPECT_FALSE(context.HasInfo());
+  EXPECT_EQ(copy.GetInfo("key"), &value);
+
+  // the parser's info is its context's
+  ISOBMFF::Parser parser;
+  parser.SetInfo("key", &value);
+  EXPECT_EQ(parser.GetInfo("key"), &value);
+  EXPECT_EQ(parser.GetContext().GetInfo("key"), &value);
+  ASSERT_FALSE(parser.Parse(std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC"));
+  EXPECT_EQ(parser.GetInfo("key"), &value);
+  parser.SetInfo("key", nullptr);
+  EXPECT_EQ(parser.GetInfo("key"), nullptr);
+}
+
+TEST_F(ISOBMFFParseContextTest, TestParses) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  std::vector<const ParseContext *> contexts;
+  int value = 0;
+  int other = 0;
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.RegisterBox("mvhd", [&]() -> std::shared_ptr<Box> {
+    ParseContext &context = parser.GetContext();
+    contexts.push_back(&context);
+    EXPECT_EQ(context.GetInfo("key"), &value);
+    EXPECT_NE(context.GetScratch().Allocate(16, 8), nullptr);
+    context.SetInfo("other", &other);
+    return std::make_shared<ISOBMFF::MVHD>();
+  }));
+  parser.SetInfo("key", &value);
+
+  // each parse has its own context, starting with the parser's values
+  ASSERT_FALSE(parser.Parse(path));
+  ASSERT_EQ(contexts.size(), 1);
+  EXPECT_NE(contexts[0], &(parser.GetContext()));
+  EXPECT_EQ(parser.GetInfo("other"), nullptr);
+  EXPECT_EQ(parser.GetContext().GetScratch().GetAllocatedSize(), 0);
+
+  ISOBMFF::BoxVisitor visitor;
+  ASSERT_FALSE(parser.Parse(path, visitor));
+  ASSERT_EQ(contexts.size(), 2);
+  EXPECT_NE(contexts[1], &(parser.GetContext()));
+  EXPECT_EQ(parser.GetInfo("other"), nullptr);
+  EXPECT_EQ(parser.GetInfo("key"), &value);
+}
+
+TEST_F(ISOBMFFParseContextTest, TestParents) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  std::vector<std::string> parents;
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.RegisterBox("tkhd", [&]() -> std::shared_ptr<Box> {
+    return std::make_shared<ParentRecordingBox>(parents);
+  }));
+
+  // boxes see the boxes they are found in
+  ASSERT_FALSE(parser.Parse(path));
+  ASSERT_EQ(parents.size(), 4);
+  for (const auto &parent : parents) {
+    EXPECT_EQ(parent, "trak");
+  }
+  EXPECT_EQ(parser.GetContext().GetDepth(), 0);
+
+  // and so do boxes read concurrently
+  parents.clear();
+  parser.AddOption(ISOBMFF::Parser::Options::ParallelDecoding);
+  parser.SetThreadPool(std::make_shared<ISOBMFF::ThreadPool>(4));
+  ASSERT_FALSE(parser.Parse(path));
+  ASSERT_EQ(parents.size(), 4);
+  for (const auto &parent : parents) {
+    EXPECT_EQ(parent, "trak");
+  }
+}
+
+TEST_F(ISOBMFFParseContextTest, TestReferences) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC";
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+  std::shared_ptr<SingleItemTypeReferenceBox> expected =
+      GetReference(parser.GetFile());
+  ASSERT_NE(expected, nullptr);
+  ASSERT_NE(expected->GetFromItemID(), 0);
+  ASSERT_FALSE(expected->GetToItemIDs().empty());
+
+  // references are read with their iref box, whatever the options
+  for (auto option : {ISOBMFF::Parser::Options::LazyDecoding,
+                      ISOBMFF::Parser::Options::ParallelDecoding}) {
+    ISOBMFF::Parser other;
+    other.AddOption(option);
+    other.SetThreadPool(std::make_shared<ISOBMFF::ThreadPool>(4));
+    ASSERT_FALSE(other.Parse(path));
+    std::shared_ptr<SingleItemTypeReferenceBox> reference =
+        GetReference(other.GetFile());
+    ASSERT_NE(reference, nullptr);
+    EXPECT_EQ(reference->GetFromItemID(), expected->GetFromItemID());
+    EXPECT_EQ(reference->GetToItemIDs(), expected->GetToItemIDs());
+  }
+
+  // outside of an iref box, references are opaque
+  std::vector<uint8_t> data = {0x00, 0x01, 0x00, 0x01, 0x00, 0x02};
+  ISOBMFF::BinaryDataStream stream(data);
+  ISOBMFF::SingleItemTypeReferenceBox box("dimg");
+  ASSERT_FALSE(box.ReadData(parser, stream));
+  EXPECT_EQ(box.GetFromItemID(), 0);
+}
+
+}  // namespace ISOBMFF
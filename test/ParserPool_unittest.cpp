@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+#include <ISOBMFF.hpp>    // for various
+#include <ParserPool.hpp> // for ParserPool
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFParserPoolTest : public ::testing::Test {
+public:
+  ISOBMFFParserPoolTest() {}
+  ~ISOBMFFParserPoolTest() override {}
+};
+
+TEST_F(ISOBMFFParserPoolTest, TestParsePaths) {
+  const std::vector<std::string> names = {"IMG1.HEIC", "IMG2.HEIC",
+                                          "MOV1.MOV"};
+  std::vector<std::string> paths;
+  std::vector<std::string> expected;
+  for (size_t i = 0; i < 30; i++) {
+    paths.push_back(std::string(TEST_MEDIA_DIR) + "/" + names[i % 3]);
+    ISOBMFF::Parser parser;
+    ASSERT_FALSE(parser.Parse(paths.back()));
+    expected.push_back(parser.GetFile()->ToString());
+  }
+  paths.push_back(std::string(TEST_MEDIA_DIR) + "/missing");
+
+  // each file is parsed once, by a worker having its own parser
+  ISOBMFF::ParserPool pool(ISOBMFF::Parser(), 4);
+  EXPECT_EQ(pool.GetWorkerCount(), 4);
+  std::vector<std::string> dumps(paths.size());
+  std::vector<int> calls(paths.size(), 0);
+  std::vector<int> errors(paths.size(), 0);
+  pool.Parse(paths, [&](size_t i, const ISOBMFF::Error &err,
+                        const std::shared_ptr<ISOBMFF::File> &file) {
+    calls[i]++;
+    errors[i] = err ? 1 : 0;
+    if (file != nullptr) {
+      dumps[i] = file->ToString();
+    }
+  });
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(calls[i], 1);
+    EXPECT_EQ(errors[i], 0);
+    EXPECT_EQ(dumps[i], expected[i]);
+  }
+  EXPECT_EQ(calls.back(), 1);
+  EXPECT_EQ(errors.back(), 1);
+  EXPECT_TRUE(dumps.back().empty());
+
+  // pools are reused from batch to batch
+  std::atomic<size_t> count(0);
+  pool.Parse(std::vector<std::string>(paths.begin(), paths.begin() + 2),
+             [&](size_t, const ISOBMFF::Error &,
+                 const std::shared_ptr<ISOBMFF::File> &) { count++; });
+  EXPECT_EQ(count, 2);
+}
+
+TEST_F(ISOBMFFParserPoolTest, TestParseBuffers) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  std::vector<uint8_t> data;
+  {
+    ISOBMFF::BinaryFileStream stream(path);
+    ASSERT_FALSE(stream.Read(data, stream.Size()));
+  }
+
+  // workers use copies of the given parser
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.AllowBoxPath("moov/mvhd"));
+  ASSERT_FALSE(parser.Parse(path));
+  std::string expected = parser.GetFile()->ToString();
+
+  ISOBMFF::ParserPool pool(parser, 3);
+  std::vector<ISOBMFF::ParserPool::Buffer> buffers(
+      10, ISOBMFF::ParserPool::Buffer(data.data(), data.size()));
+  std::vector<std::string> dumps(buffers.size());
+  pool.Parse(buffers, [&](size_t i, const ISOBMFF::Error &err,
+                          const std::shared_ptr<ISOBMFF::File> &file) {
+    EXPECT_FALSE(err);
+    if (file != nullptr) {
+      dumps[i] = file->ToString();
+    }
+  });
+  for (const auto &dump : dumps) {
+    EXPECT_EQ(dump, expected);
+  }
+
+  // files kept by the callback outlive the batch
+  std::shared_ptr<ISOBMFF::File> kept;
+  pool.Parse(std::vector<ISOBMFF::ParserPool::Buffer>(1, buffers[0]),
+             [&](size_t, const ISOBMFF::Error &,
+                 const std::shared_ptr<ISOBMFF::File> &file) { kept = file; });
+  ASSERT_NE(kept, nullptr);
+  EXPECT_EQ(kept->ToString(), expected);
+}
+
+}  // namespace ISOBMFF
@@ -4,6 +4,11 @@
 #include <ISOBMFF.hpp>        // for various
 #include <Parser.hpp> // for Parser
 
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -381,4 +386,579 @@ TEST_F(ISOBMFFParserTest, TestSampleVideo) {
   }
 }
 
+TEST_F(ISOBMFFParserTest, TestParseBorrowedData) {
+  std::vector<uint8_t> data;
+  ISOBMFF::BinaryFileStream file(std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC");
+  ASSERT_FALSE(file.ReadAllData(data));
+
+  // borrowed bytes produce the same tree as copied ones
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(data));
+  std::string dump = parser.GetFile()->ToString();
+  ASSERT_FALSE(parser.Parse(data.data(), data.size()));
+  EXPECT_EQ(parser.GetFile()->ToString(), dump);
+
+  // a truncated window is read as such
+  EXPECT_TRUE(parser.Parse(data.data(), 4));
+  EXPECT_TRUE(parser.Parse(nullptr, 0));
+}
+
+TEST_F(ISOBMFFParserTest, TestBoxLocation) {
+  const std::vector<uint8_t> buffer = {
+      // ftyp
+      0x00, 0x00, 0x00, 0x10, 0x66, 0x74, 0x79, 0x70,
+      0x69, 0x73, 0x6f, 0x6d, 0x00, 0x00, 0x00, 0x00,
+      // free, with a 64-bit size
+      0x00, 0x00, 0x00, 0x01, 0x66, 0x72, 0x65, 0x65,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      // moov
+      0x00, 0x00, 0x00, 0x18, 0x6d, 0x6f, 0x6f, 0x76,
+      // udta
+      0x00, 0x00, 0x00, 0x10, 0x75, 0x64, 0x74, 0x61,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  };
+
+  for (bool lazy : {false, true}) {
+    ISOBMFF::Parser parser;
+    if (lazy) {
+      parser.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+    }
+    ASSERT_FALSE(parser.Parse(buffer));
+
+    std::vector<std::shared_ptr<ISOBMFF::Box> > boxes =
+        parser.GetFile()->GetBoxes();
+    ASSERT_EQ(boxes.size(), 3u);
+    EXPECT_EQ(boxes[0]->GetOffset(), 0u);
+    EXPECT_EQ(boxes[0]->GetHeaderSize(), 8u);
+    EXPECT_EQ(boxes[0]->GetSize(), 16u);
+    EXPECT_EQ(boxes[1]->GetOffset(), 16u);
+    EXPECT_EQ(boxes[1]->GetHeaderSize(), 16u);
+    EXPECT_EQ(boxes[1]->GetSize(), 24u);
+    EXPECT_EQ(boxes[2]->GetOffset(), 40u);
+    EXPECT_EQ(boxes[2]->GetHeaderSize(), 8u);
+    EXPECT_EQ(boxes[2]->GetSize(), 24u);
+
+    // nested boxes are located in the file, not in their parent
+    std::shared_ptr<ISOBMFF::Box> udta =
+        parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov")->GetBox(
+            "udta");
+    ASSERT_NE(udta, nullptr);
+    EXPECT_EQ(udta->GetOffset(), 48u);
+    EXPECT_EQ(udta->GetHeaderSize(), 8u);
+    EXPECT_EQ(udta->GetSize(), 16u);
+  }
+
+  // siblings are contiguous in a real file
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(std::string(TEST_MEDIA_DIR) + "/MOV1.MOV"));
+  std::shared_ptr<ISOBMFF::ContainerBox> moov =
+      parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov");
+  ASSERT_NE(moov, nullptr);
+  uint64_t offset = moov->GetOffset() + moov->GetHeaderSize();
+  for (const auto& box : moov->GetBoxes()) {
+    EXPECT_EQ(box->GetOffset(), offset) << box->GetName();
+    offset += box->GetSize();
+  }
+  EXPECT_EQ(offset, moov->GetOffset() + moov->GetSize());
+}
+
+TEST_F(ISOBMFFParserTest, TestScan) {
+  ISOBMFF::Parser parser;
+  std::vector<ISOBMFF::Parser::BoxMapEntry> boxes;
+
+  // the map agrees with the parsed tree
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  ASSERT_FALSE(parser.Parse(path));
+  ASSERT_FALSE(parser.Scan(path, boxes));
+  std::vector<std::shared_ptr<ISOBMFF::Box> > top =
+      parser.GetFile()->GetBoxes();
+  std::vector<std::shared_ptr<ISOBMFF::Box> > moov =
+      parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov")
+          ->GetBoxes();
+  size_t topCount = 0;
+  size_t moovCount = 0;
+  for (const auto& entry : boxes) {
+    std::shared_ptr<ISOBMFF::Box> box;
+    if (entry.path.find('/') == std::string::npos) {
+      ASSERT_LT(topCount, top.size());
+      box = top[topCount++];
+    } else if (entry.path.rfind('/') == 4 &&
+               entry.path.compare(0, 5, "moov/") == 0) {
+      ASSERT_LT(moovCount, moov.size());
+      box = moov[moovCount++];
+    } else {
+      continue;
+    }
+    EXPECT_EQ(ISOBMFF::Utils::FourCCToString(entry.type), box->GetName());
+    EXPECT_EQ(entry.offset, box->GetOffset());
+    EXPECT_EQ(entry.headerSize, box->GetHeaderSize());
+    EXPECT_EQ(entry.size, box->GetSize());
+  }
+  EXPECT_EQ(topCount, top.size());
+  EXPECT_EQ(moovCount, moov.size());
+  EXPECT_EQ(std::count_if(boxes.begin(), boxes.end(),
+                          [](const ISOBMFF::Parser::BoxMapEntry& entry) {
+                            return entry.path ==
+                                   "moov/trak/mdia/minf/stbl/stts";
+                          }),
+            4);
+
+  // meta and ipco are descended into, other boxes are not
+  ASSERT_FALSE(
+      parser.Scan(std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC", boxes));
+  auto find = [&](const std::string& prefix) {
+    return std::find_if(boxes.begin(), boxes.end(),
+                        [&](const ISOBMFF::Parser::BoxMapEntry& entry) {
+                          return entry.path.compare(0, prefix.size(),
+                                                    prefix) == 0;
+                        }) != boxes.end();
+  };
+  EXPECT_TRUE(find("meta/iinf"));
+  EXPECT_TRUE(find("meta/iprp/ipco/ispe"));
+  EXPECT_FALSE(find("meta/iinf/"));
+
+  const std::vector<uint8_t> buffer = {
+      // ftyp
+      0x00, 0x00, 0x00, 0x10, 0x66, 0x74, 0x79, 0x70,
+      0x69, 0x73, 0x6f, 0x6d, 0x00, 0x00, 0x00, 0x00,
+      // moov, with a QuickTime terminator
+      0x00, 0x00, 0x00, 0x0c, 0x6d, 0x6f, 0x6f, 0x76,
+      0x00, 0x00, 0x00, 0x00,
+      // mdat, up to the end of the file
+      0x00, 0x00, 0x00, 0x00, 0x6d, 0x64, 0x61, 0x74,
+      0x01, 0x02, 0x03, 0x04,
+  };
+  ASSERT_FALSE(parser.Scan(buffer.data(), buffer.size(), boxes));
+  ASSERT_EQ(boxes.size(), 3u);
+  EXPECT_EQ(boxes[1].path, "moov");
+  EXPECT_EQ(boxes[2].path, "mdat");
+  EXPECT_EQ(boxes[2].offset, 28u);
+  EXPECT_EQ(boxes[2].size, 12u);
+
+  // boxes found before an error are kept
+  EXPECT_EQ(parser.Scan(buffer.data(), 30, boxes).GetCode(),
+            ISOBMFF::ErrorCode::InsufficientData);
+  EXPECT_EQ(boxes.size(), 2u);
+  EXPECT_EQ(parser.Scan(buffer.data() + 4, 8, boxes).GetCode(),
+            ISOBMFF::ErrorCode::NotISOMediaFile);
+
+  // the stream position is left unchanged
+  ISOBMFF::BinaryDataStream stream(buffer);
+  EXPECT_FALSE(stream.Seek(16, ISOBMFF::BinaryStream::SeekDirection::Begin));
+  ASSERT_FALSE(parser.Scan(stream, boxes));
+  EXPECT_EQ(boxes.size(), 2u);
+  EXPECT_EQ(boxes[0].offset, 16u);
+  EXPECT_EQ(stream.Tell(), 16u);
+}
+
+TEST_F(ISOBMFFParserTest, TestBoxPathFilter) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+
+  ISOBMFF::Parser parser;
+  EXPECT_TRUE(parser.AllowBoxPath("moov/track"));
+  EXPECT_TRUE(parser.DenyBoxPath("moov//trak"));
+  ASSERT_FALSE(parser.AllowBoxPath("moov/trak/mdia/minf/stbl/*"));
+  ASSERT_FALSE(parser.Parse(path));
+  std::string filteredDump = parser.GetFile()->ToString();
+
+  // boxes outside the filter are kept, but not read
+  std::shared_ptr<ISOBMFF::ContainerBox> moov =
+      parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov");
+  ASSERT_NE(moov, nullptr);
+  ASSERT_NE(moov->GetBox("mvhd"), nullptr);
+  EXPECT_EQ(moov->GetTypedBox<ISOBMFF::MVHD>("mvhd"), nullptr);
+  std::shared_ptr<ISOBMFF::ContainerBox> trak =
+      moov->GetTypedBox<ISOBMFF::ContainerBox>("trak");
+  ASSERT_NE(trak, nullptr);
+  EXPECT_EQ(trak->GetTypedBox<ISOBMFF::TKHD>("tkhd"), nullptr);
+  std::shared_ptr<ISOBMFF::ContainerBox> stbl =
+      trak->GetTypedBox<ISOBMFF::ContainerBox>("mdia")
+          ->GetTypedBox<ISOBMFF::ContainerBox>("minf")
+          ->GetTypedBox<ISOBMFF::ContainerBox>("stbl");
+  ASSERT_NE(stbl, nullptr);
+  EXPECT_NE(stbl->GetTypedBox<ISOBMFF::STTS>("stts"), nullptr);
+  EXPECT_NE(stbl->GetTypedBox<ISOBMFF::STSD>("stsd"), nullptr);
+
+  // denied paths take precedence
+  ASSERT_FALSE(parser.DenyBoxPath("*/*/*/*/stbl/stts"));
+  ASSERT_FALSE(parser.Parse(path));
+  stbl = parser.GetFile()
+             ->GetTypedBox<ISOBMFF::ContainerBox>("moov")
+             ->GetTypedBox<ISOBMFF::ContainerBox>("trak")
+             ->GetTypedBox<ISOBMFF::ContainerBox>("mdia")
+             ->GetTypedBox<ISOBMFF::ContainerBox>("minf")
+             ->GetTypedBox<ISOBMFF::ContainerBox>("stbl");
+  ASSERT_NE(stbl, nullptr);
+  EXPECT_EQ(stbl->GetTypedBox<ISOBMFF::STTS>("stts"), nullptr);
+  EXPECT_NE(stbl->GetTypedBox<ISOBMFF::STSD>("stsd"), nullptr);
+
+  // filters are applied to deferred boxes when they are loaded
+  ISOBMFF::Parser lazy;
+  lazy.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+  ASSERT_FALSE(lazy.AllowBoxPath("moov/trak/mdia/minf/stbl/*"));
+  ASSERT_FALSE(lazy.Parse(path));
+  EXPECT_EQ(lazy.GetFile()->ToString(), filteredDump);
+
+  // boxes of a full box container are filtered too
+  ISOBMFF::Parser heif;
+  ASSERT_FALSE(heif.AllowBoxPath("meta/iloc"));
+  ASSERT_FALSE(heif.Parse(std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC"));
+  std::shared_ptr<ISOBMFF::META> meta =
+      heif.GetFile()->GetTypedBox<ISOBMFF::META>("meta");
+  ASSERT_NE(meta, nullptr);
+  EXPECT_NE(meta->GetTypedBox<ISOBMFF::ILOC>("iloc"), nullptr);
+  EXPECT_EQ(meta->GetTypedBox<ISOBMFF::IINF>("iinf"), nullptr);
+  EXPECT_NE(meta->GetBox("iinf"), nullptr);
+
+  parser.ClearBoxPaths();
+  ASSERT_FALSE(parser.Parse(path));
+  EXPECT_NE(parser.GetFile()
+                ->GetTypedBox<ISOBMFF::ContainerBox>("moov")
+                ->GetTypedBox<ISOBMFF::MVHD>("mvhd"),
+            nullptr);
+}
+
+TEST_F(ISOBMFFParserTest, TestRegisterBox) {
+  EXPECT_EQ(ISOBMFF::Utils::FourCC("ftyp"), 0x66747970u);
+  EXPECT_EQ(ISOBMFF::Utils::FourCC("ftypx"), 0u);
+  EXPECT_EQ(ISOBMFF::Utils::FourCCToString(0x66747970u), "ftyp");
+
+  ISOBMFF::Parser parser;
+  EXPECT_NE(std::dynamic_pointer_cast<ISOBMFF::STTS>(parser.CreateBox("stts")),
+            nullptr);
+  EXPECT_NE(std::dynamic_pointer_cast<ISOBMFF::ContainerBox>(
+                parser.CreateBox("moov")),
+            nullptr);
+  EXPECT_EQ(parser.CreateBox("abcd")->GetName(), "abcd");
+  EXPECT_EQ(parser.CreateBox("abc")->GetName(), "abc");
+  EXPECT_TRUE(parser.RegisterBox("abc", nullptr));
+
+  // registrations override the defaults, and survive copies
+  EXPECT_FALSE(parser.RegisterContainerBox("stts"));
+  EXPECT_FALSE(parser.RegisterBox("moov", nullptr));
+  EXPECT_FALSE(parser.RegisterContainerBox("abcd"));
+
+  ISOBMFF::Parser copy(parser);
+  for (const ISOBMFF::Parser* p : {&parser, &copy}) {
+    EXPECT_NE(std::dynamic_pointer_cast<ISOBMFF::ContainerBox>(
+                  p->CreateBox("stts")),
+              nullptr);
+    EXPECT_EQ(std::dynamic_pointer_cast<ISOBMFF::ContainerBox>(
+                  p->CreateBox("moov")),
+              nullptr);
+    EXPECT_EQ(p->CreateBox("moov")->GetName(), "moov");
+    EXPECT_NE(std::dynamic_pointer_cast<ISOBMFF::ContainerBox>(
+                  p->CreateBox("abcd")),
+              nullptr);
+  }
+
+  // other parsers still use the defaults
+  ISOBMFF::Parser other;
+  EXPECT_NE(std::dynamic_pointer_cast<ISOBMFF::STTS>(other.CreateBox("stts")),
+            nullptr);
+}
+
+TEST_F(ISOBMFFParserTest, TestArenaAllocation) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+  std::string heapDump = parser.GetFile()->ToString();
+
+  parser.AddOption(ISOBMFF::Parser::Options::ArenaAllocation);
+  ASSERT_FALSE(parser.Parse(path));
+  EXPECT_EQ(parser.GetFile()->ToString(), heapDump);
+
+  // boxes keep the arena alive after the file is released
+  std::shared_ptr<ISOBMFF::ContainerBox> moov =
+      parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov");
+  ASSERT_NE(moov, nullptr);
+  parser = ISOBMFF::Parser();
+  std::shared_ptr<ISOBMFF::Box> trak = moov->GetBox("trak");
+  ASSERT_NE(trak, nullptr);
+  EXPECT_EQ(trak->GetName(), "trak");
+
+  // copies of arena boxes are regular heap objects
+  ISOBMFF::ContainerBox copy(*(moov));
+  moov = nullptr;
+  trak = nullptr;
+  EXPECT_NE(copy.GetBox("mvhd"), nullptr);
+
+  // arenas combine with lazy decoding
+  ISOBMFF::Parser lazy;
+  lazy.AddOption(ISOBMFF::Parser::Options::ArenaAllocation);
+  lazy.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+  ASSERT_FALSE(lazy.Parse(path));
+  EXPECT_EQ(lazy.GetFile()->ToString(), heapDump);
+
+  ISOBMFF::Arena arena(256);
+  {
+    ISOBMFF::Arena::Scope scope(&arena);
+    EXPECT_EQ(ISOBMFF::Arena::GetCurrent(), &arena);
+    ISOBMFF::STTS stts;
+    EXPECT_GT(arena.GetAllocatedSize(), 0u);
+  }
+  EXPECT_EQ(ISOBMFF::Arena::GetCurrent(), nullptr);
+  EXPECT_NE(arena.Allocate(1000, 8), nullptr);
+  EXPECT_GE(arena.GetReservedSize(), arena.GetAllocatedSize());
+}
+
+TEST_F(ISOBMFFParserTest, TestParallelDecoding) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+  std::shared_ptr<ISOBMFF::File> sequential = parser.GetFile();
+
+  // the tracks are read concurrently, and the tree is the same
+  ISOBMFF::Parser parallel;
+  parallel.AddOption(ISOBMFF::Parser::Options::ParallelDecoding);
+  parallel.SetThreadPool(std::make_shared<ISOBMFF::ThreadPool>(4));
+  ASSERT_FALSE(parallel.Parse(path));
+  EXPECT_EQ(parallel.GetFile()->ToString(), sequential->ToString());
+
+  std::function<void(const std::shared_ptr<ISOBMFF::Box>&,
+                     const std::shared_ptr<ISOBMFF::Box>&)>
+      compare = [&](const std::shared_ptr<ISOBMFF::Box>& expected,
+                    const std::shared_ptr<ISOBMFF::Box>& actual) {
+        ASSERT_NE(actual, nullptr);
+        EXPECT_EQ(actual->GetName(), expected->GetName());
+        EXPECT_EQ(actual->GetOffset(), expected->GetOffset());
+        EXPECT_EQ(actual->GetSize(), expected->GetSize());
+        ISOBMFF::Container* container =
+            dynamic_cast<ISOBMFF::Container*>(expected.get());
+        if (container == nullptr) return;
+        std::vector<std::shared_ptr<ISOBMFF::Box> > e =
+            container->GetBoxes();
+        std::vector<std::shared_ptr<ISOBMFF::Box> > a =
+            dynamic_cast<ISOBMFF::Container*>(actual.get())->GetBoxes();
+        ASSERT_EQ(a.size(), e.size());
+        for (size_t i = 0; i < e.size(); i++) compare(e[i], a[i]);
+      };
+  compare(sequential, parallel.GetFile());
+
+  // mapped files are parsed in place, and other files are read first
+  parallel.AddOption(ISOBMFF::Parser::Options::DoNotMapFiles);
+  ASSERT_FALSE(parallel.Parse(path));
+  EXPECT_EQ(parallel.GetFile()->ToString(), sequential->ToString());
+  parallel.RemoveOption(ISOBMFF::Parser::Options::DoNotMapFiles);
+
+  // with arenas, filters, and from memory
+  parallel.AddOption(ISOBMFF::Parser::Options::ArenaAllocation);
+  ASSERT_FALSE(parallel.Parse(path));
+  EXPECT_EQ(parallel.GetFile()->ToString(), sequential->ToString());
+  ASSERT_FALSE(parallel.DenyBoxPath("moov/trak/mdia/minf/stbl/stts"));
+  ASSERT_FALSE(parser.DenyBoxPath("moov/trak/mdia/minf/stbl/stts"));
+  ASSERT_FALSE(parser.Parse(path));
+  std::vector<uint8_t> data;
+  {
+    ISOBMFF::BinaryFileStream stream(path);
+    ASSERT_FALSE(stream.Read(data, stream.Size()));
+  }
+  ASSERT_FALSE(parallel.Parse(data.data(), data.size()));
+  EXPECT_EQ(parallel.GetFile()->ToString(), parser.GetFile()->ToString());
+
+  // errors are the ones of the first failing box
+  data[0x1c + 0x100] ^= 0xff;
+  EXPECT_EQ(static_cast<bool>(parallel.Parse(data.data(), data.size())),
+            static_cast<bool>(parser.Parse(data.data(), data.size())));
+
+  // pools run nested tasks without waiting for a free thread
+  ISOBMFF::ThreadPool pool(1);
+  EXPECT_EQ(pool.GetThreadCount(), 1u);
+  std::atomic<int> count(0);
+  std::vector<ISOBMFF::ThreadPool::Task> inner(8, [&]() { count++; });
+  std::vector<ISOBMFF::ThreadPool::Task> outer(4, [&]() { pool.Run(inner); });
+  pool.Run(outer);
+  EXPECT_EQ(count, 32);
+}
+
+TEST_F(ISOBMFFParserTest, TestLazyDecoding) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/IMG1.HEIC";
+
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+  std::string eagerDump = parser.GetFile()->ToString();
+
+  parser.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+  ASSERT_FALSE(parser.Parse(path));
+  std::shared_ptr<ISOBMFF::File> file = parser.GetFile();
+
+  // only headers were read
+  std::shared_ptr<ISOBMFF::Box> meta;
+  for (const auto& box : file->GetBoxes()) {
+    if (box->GetName() == "meta") {
+      meta = box;
+    }
+  }
+  ASSERT_NE(meta, nullptr);
+  EXPECT_FALSE(meta->IsLoaded());
+
+  // accessing a box by name loads it, but not its siblings
+  std::shared_ptr<ISOBMFF::META> typedMeta =
+      file->GetTypedBox<ISOBMFF::META>("meta");
+  ASSERT_NE(typedMeta, nullptr);
+  EXPECT_TRUE(typedMeta->IsLoaded());
+
+  std::shared_ptr<ISOBMFF::Box> ipma;
+  for (const auto& box : typedMeta->GetBoxes()) {
+    if (box->GetName() == "iprp") {
+      ipma = std::dynamic_pointer_cast<ISOBMFF::ContainerBox>(box)->GetBoxes()
+                 .back();
+    }
+  }
+  ASSERT_NE(ipma, nullptr);
+  EXPECT_EQ(ipma->GetName(), "ipma");
+  EXPECT_FALSE(ipma->IsLoaded());
+
+  std::shared_ptr<ISOBMFF::PITM> pitm =
+      typedMeta->GetTypedBox<ISOBMFF::PITM>("pitm");
+  ASSERT_NE(pitm, nullptr);
+  EXPECT_TRUE(pitm->IsLoaded());
+  EXPECT_FALSE(ipma->IsLoaded());
+
+  // the parser and the file can go away before the boxes are loaded
+  parser = ISOBMFF::Parser();
+  file = nullptr;
+  ASSERT_FALSE(ipma->Load());
+  EXPECT_TRUE(ipma->IsLoaded());
+
+  // describing the file loads everything
+  ISOBMFF::Parser lazy;
+  lazy.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+  ASSERT_FALSE(lazy.Parse(path));
+  EXPECT_EQ(lazy.GetFile()->ToString(), eagerDump);
+
+  // data vectors are retained by the parsed boxes
+  {
+    std::vector<uint8_t> data;
+    ISOBMFF::BinaryFileStream stream(path);
+    ASSERT_FALSE(stream.ReadAllData(data));
+    ASSERT_FALSE(lazy.Parse(data));
+  }
+  EXPECT_EQ(lazy.GetFile()->ToString(), eagerDump);
+}
+
+TEST_F(ISOBMFFParserTest, TestLazyDecodingError) {
+  const std::vector<uint8_t> buffer = {
+      // ftyp
+      0x00, 0x00, 0x00, 0x10, 0x66, 0x74, 0x79, 0x70,
+      0x69, 0x73, 0x6f, 0x6d, 0x00, 0x00, 0x00, 0x00,
+      // moov
+      0x00, 0x00, 0x00, 0x20, 0x6d, 0x6f, 0x6f, 0x76,
+      // stts, claiming more entries than it holds
+      0x00, 0x00, 0x00, 0x18, 0x73, 0x74, 0x74, 0x73,
+      0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+      0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x0b, 0xb8,
+  };
+
+  ISOBMFF::Parser parser;
+  EXPECT_TRUE(parser.Parse(buffer));
+  parser.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+  ASSERT_FALSE(parser.Parse(buffer));
+
+  // boxes failing to load are returned unloaded, and keep their error
+  std::shared_ptr<ISOBMFF::ContainerBox> moov =
+      parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov");
+  ASSERT_NE(moov, nullptr);
+  std::shared_ptr<ISOBMFF::Box> stts = moov->GetBox("stts");
+  ASSERT_NE(stts, nullptr);
+  EXPECT_FALSE(stts->IsLoaded());
+  ISOBMFF::Error error = stts->Load();
+  EXPECT_TRUE(error);
+  EXPECT_EQ(stts->Load().GetCode(), error.GetCode());
+  EXPECT_EQ(stts->Load().GetMessage(), error.GetMessage());
+  EXPECT_FALSE(stts->IsLoaded());
+
+  // copies keep the error
+  ISOBMFF::Box copy(*(stts));
+  EXPECT_TRUE(copy.Load());
+  EXPECT_FALSE(copy.IsLoaded());
+}
+
+// a file whose boxes are nested the given number of times, each box
+// starting with the given number of zero bytes before its child
+static std::vector<uint8_t> NestedBoxes(const std::string &type, size_t depth,
+                                        size_t fields) {
+  std::vector<uint8_t> data = {0x00, 0x00, 0x00, 0x10, 'f', 't', 'y', 'p',
+                               'i',  's',  'o',  'm',  0x00, 0x00, 0x00, 0x00};
+  for (size_t i = 0; i < depth; i++) {
+    uint32_t size = static_cast<uint32_t>((depth - i) * (8 + fields));
+    const uint8_t header[8] = {
+        static_cast<uint8_t>(size >> 24), static_cast<uint8_t>(size >> 16),
+        static_cast<uint8_t>(size >> 8),  static_cast<uint8_t>(size),
+        static_cast<uint8_t>(type[0]),    static_cast<uint8_t>(type[1]),
+        static_cast<uint8_t>(type[2]),    static_cast<uint8_t>(type[3])};
+    data.insert(data.end(), header, header + sizeof(header));
+    data.insert(data.end(), fields, 0x00);
+  }
+  return data;
+}
+
+TEST_F(ISOBMFFParserTest, TestMaxDepth) {
+  const std::vector<uint8_t> deep = NestedBoxes("moov", 5000, 0);
+  ISOBMFF::Parser parser;
+  EXPECT_EQ(parser.GetMaxDepth(), ISOBMFF::Parser::DefaultMaxDepth);
+
+  // boxes nested too deeply are an error
+  EXPECT_TRUE(parser.Parse(deep));
+  ISOBMFF::BoxVisitor visitor;
+  EXPECT_TRUE(parser.Parse(deep.data(), deep.size(), visitor));
+
+  // containers are read without recursion
+  parser.SetMaxDepth(10000);
+  ASSERT_FALSE(parser.Parse(deep));
+  size_t depth = 0;
+  std::shared_ptr<ISOBMFF::ContainerBox> box =
+      parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov");
+  while (box != nullptr) {
+    EXPECT_EQ(box->GetOffset(), 16 + depth * 8);
+    depth++;
+    box = box->GetTypedBox<ISOBMFF::ContainerBox>("moov");
+  }
+  EXPECT_EQ(depth, 5000);
+  EXPECT_EQ(parser.GetContext().GetDepth(), 0);
+  ISOBMFF::Parser copy(parser);
+  EXPECT_EQ(copy.GetMaxDepth(), 10000);
+
+  // other boxes having children are read recursively, and are limited too
+  parser.SetMaxDepth(ISOBMFF::Parser::DefaultMaxDepth);
+  EXPECT_TRUE(parser.Parse(NestedBoxes("stsd", 100000, 8)));
+  parser.SetMaxDepth(100);
+  ASSERT_FALSE(parser.Parse(NestedBoxes("stsd", 100, 8)));
+  EXPECT_TRUE(parser.Parse(NestedBoxes("stsd", 101, 8)));
+
+  // and so are boxes read at the end of their level, or by workers, here
+  // in two sibling chains
+  auto siblings = [](size_t depth) {
+    std::vector<uint8_t> chain = NestedBoxes("moov", depth - 1, 0);
+    std::vector<uint8_t> data = NestedBoxes("moov", 1, 0);
+    chain.erase(chain.begin(), chain.begin() + 16);
+    data.insert(data.end(), chain.begin(), chain.end());
+    data.insert(data.end(), chain.begin(), chain.end());
+    uint32_t size = static_cast<uint32_t>(data.size() - 16);
+    data[16] = static_cast<uint8_t>(size >> 24);
+    data[17] = static_cast<uint8_t>(size >> 16);
+    data[18] = static_cast<uint8_t>(size >> 8);
+    data[19] = static_cast<uint8_t>(size);
+    return data;
+  };
+  for (size_t threads : {size_t(1), size_t(4)}) {
+    ISOBMFF::Parser parallel;
+    parallel.AddOption(ISOBMFF::Parser::Options::ParallelDecoding);
+    parallel.SetThreadPool(std::make_shared<ISOBMFF::ThreadPool>(threads));
+    EXPECT_TRUE(parallel.Parse(NestedBoxes("moov", 100, 0)));
+    EXPECT_TRUE(parallel.Parse(NestedBoxes("moov", 1000000, 0)));
+    EXPECT_TRUE(parallel.Parse(siblings(100)));
+    EXPECT_TRUE(parallel.Parse(siblings(1000000)));
+    parallel.SetMaxDepth(100);
+    ASSERT_FALSE(parallel.Parse(NestedBoxes("moov", 100, 0)));
+    EXPECT_TRUE(parallel.Parse(NestedBoxes("moov", 101, 0)));
+    ASSERT_FALSE(parallel.Parse(siblings(100)));
+    EXPECT_TRUE(parallel.Parse(siblings(101)));
+    EXPECT_EQ(parallel.GetContext().GetDepth(), 0);
+  }
+}
+
 } // namespace ISOBMFF
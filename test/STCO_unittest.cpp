@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+
+#include <ISOBMFF.hpp>                  // for various
+#include <BinaryDataStream.hpp> // for BinaryDataStream
+#include <Parser.hpp>           // for Parser
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFSTCOTest : public ::testing::Test {
+public:
+  ISOBMFFSTCOTest() {}
+  ~ISOBMFFSTCOTest() override {}
+};
+
+TEST_F(ISOBMFFSTCOTest, TestSTCOParser) {
+  // fuzzer::conv: data
+  const std::vector<uint8_t> &buffer = {
+      // stco size: 28 bytes
+      // 0x00, 0x00, 0x00, 0x1c,
+      // stco
+      // 0x73, 0x74, 0x63, 0x6f,
+      // stco content:
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+      0x00, 0x00, 0x00, 0x24, 0x00, 0x01, 0x2c, 0x73,
+      0xff, 0xff, 0xff, 0xf0
+  };
+
+  // fuzzer::conv: begin
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  std::shared_ptr<ISOBMFF::Box> box = parser.CreateBox("stco");
+
+  ISOBMFF::Error error;
+  if (box != nullptr) {
+    error = box->ReadData(parser, stream);
+  }
+  if (error) {
+    fprintf(stderr, "Parse error: %s\n", error.GetMessage().c_str());
+  }
+  // fuzzer::conv: end
+
+  // Validate STCO box
+  auto stco = std::dynamic_pointer_cast<ISOBMFF::STCO>(box);
+  ASSERT_NE(stco, nullptr) << "Failed to cast to STCO";
+
+  // Validate chunk offsets
+  EXPECT_EQ(stco->GetEntryCount(), 3);
+  EXPECT_EQ(stco->GetChunkOffset(0), 36);
+  EXPECT_EQ(stco->GetChunkOffset(1), 76915);
+  EXPECT_EQ(stco->GetChunkOffset(2), 4294967280u);
+}
+
+TEST_F(ISOBMFFSTCOTest, TestTruncated) {
+  // tables larger than the box
+  const std::vector<uint8_t> &buffer = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+      0x00, 0x00, 0x00, 0x24, 0x00, 0x01
+  };
+
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  ISOBMFF::STCO stco;
+  EXPECT_TRUE(stco.ReadData(parser, stream));
+}
+} // namespace ISOBMFF
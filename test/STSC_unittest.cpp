@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+
+#include <ISOBMFF.hpp>                  // for various
+#include <BinaryDataStream.hpp> // for BinaryDataStream
+#include <Parser.hpp>           // for Parser
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFSTSCTest : public ::testing::Test {
+public:
+  ISOBMFFSTSCTest() {}
+  ~ISOBMFFSTSCTest() override {}
+};
+
+// chunk offsets 100, 200, ...
+class TestChunkOffsets : public ChunkOffsets {
+public:
+  TestChunkOffsets(size_t count) : _count(count) {}
+
+  size_t GetEntryCount() const override { return _count; }
+  uint64_t GetChunkOffset(size_t index) const override {
+    return (index + 1) * 100;
+  }
+
+private:
+  size_t _count;
+};
+
+static std::shared_ptr<STSC> ReadSTSC(const std::vector<uint32_t> &entries) {
+  std::vector<uint32_t> values = {0, static_cast<uint32_t>(entries.size() / 3)};
+  values.insert(values.end(), entries.begin(), entries.end());
+  std::vector<uint8_t> buffer;
+  for (uint32_t value : values) {
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value));
+  }
+
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  auto stsc = std::make_shared<STSC>();
+  EXPECT_FALSE(stsc->ReadData(parser, stream));
+  return stsc;
+}
+
+TEST_F(ISOBMFFSTSCTest, TestSTSCParser) {
+  // fuzzer::conv: data
+  const std::vector<uint8_t> &buffer = {
+      // stsc size: 52 bytes
+      // 0x00, 0x00, 0x00, 0x34,
+      // stsc
+      // 0x73, 0x74, 0x73, 0x63,
+      // stsc content:
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03,
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03,
+      0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01,
+      0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x05,
+      0x00, 0x00, 0x00, 0x02
+  };
+
+  // fuzzer::conv: begin
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  std::shared_ptr<ISOBMFF::Box> box = parser.CreateBox("stsc");
+
+  ISOBMFF::Error error;
+  if (box != nullptr) {
+    error = box->ReadData(parser, stream);
+  }
+  if (error) {
+    fprintf(stderr, "Parse error: %s\n", error.GetMessage().c_str());
+  }
+  // fuzzer::conv: end
+
+  // Validate STSC box
+  auto stsc = std::dynamic_pointer_cast<ISOBMFF::STSC>(box);
+  ASSERT_NE(stsc, nullptr) << "Failed to cast to STSC";
+
+  // Validate entries
+  ASSERT_EQ(stsc->GetEntryCount(), 3);
+  EXPECT_EQ(stsc->GetFirstChunk(0), 1);
+  EXPECT_EQ(stsc->GetSamplesPerChunk(0), 3);
+  EXPECT_EQ(stsc->GetSampleDescriptionIndex(0), 1);
+  EXPECT_EQ(stsc->GetFirstChunk(1), 3);
+  EXPECT_EQ(stsc->GetSamplesPerChunk(1), 2);
+  EXPECT_EQ(stsc->GetSampleDescriptionIndex(1), 1);
+  EXPECT_EQ(stsc->GetFirstChunk(2), 4);
+  EXPECT_EQ(stsc->GetSamplesPerChunk(2), 5);
+  EXPECT_EQ(stsc->GetSampleDescriptionIndex(2), 2);
+}
+
+TEST_F(ISOBMFFSTSCTest, TestGetChunks) {
+  std::shared_ptr<STSC> stsc = ReadSTSC({1, 3, 1, 3, 2, 1, 4, 5, 2});
+  std::vector<STSC::Chunk> chunks;
+
+  // the last entry runs until the last chunk
+  ASSERT_FALSE(stsc->GetChunks(TestChunkOffsets(5), chunks));
+  ASSERT_EQ(chunks.size(), 5);
+  const uint32_t first[] = {0, 3, 6, 8, 13};
+  const uint32_t count[] = {3, 3, 2, 5, 5};
+  const uint32_t description[] = {1, 1, 1, 2, 2};
+  for (size_t i = 0; i < chunks.size(); i++) {
+    EXPECT_EQ(chunks[i].offset, (i + 1) * 100);
+    EXPECT_EQ(chunks[i].firstSample, first[i]);
+    EXPECT_EQ(chunks[i].sampleCount, count[i]);
+    EXPECT_EQ(chunks[i].sampleDescriptionIndex, description[i]);
+  }
+
+  // entries past the last chunk are ignored
+  ASSERT_FALSE(stsc->GetChunks(TestChunkOffsets(2), chunks));
+  ASSERT_EQ(chunks.size(), 2);
+  EXPECT_EQ(chunks[1].firstSample, 3);
+  ASSERT_FALSE(stsc->GetChunks(TestChunkOffsets(0), chunks));
+  EXPECT_TRUE(chunks.empty());
+
+  // and so are offsets given by the boxes
+  std::vector<uint8_t> data = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+                               0x00, 0x00, 0x00, 0x24};
+  ISOBMFF::BinaryDataStream stream(data);
+  ISOBMFF::Parser parser;
+  ISOBMFF::STCO stco;
+  ASSERT_FALSE(stco.ReadData(parser, stream));
+  ASSERT_FALSE(stsc->GetChunks(stco, chunks));
+  ASSERT_EQ(chunks.size(), 1);
+  EXPECT_EQ(chunks[0].offset, 36);
+  EXPECT_EQ(chunks[0].sampleCount, 3);
+}
+
+TEST_F(ISOBMFFSTSCTest, TestInvalidChunks) {
+  std::vector<STSC::Chunk> chunks;
+
+  // chunks without entries
+  EXPECT_TRUE(ReadSTSC({})->GetChunks(TestChunkOffsets(1), chunks));
+  EXPECT_TRUE(ReadSTSC({2, 1, 1})->GetChunks(TestChunkOffsets(2), chunks));
+
+  // entries out of order
+  EXPECT_TRUE(ReadSTSC({1, 1, 1, 3, 1, 1, 3, 1, 1})
+                  ->GetChunks(TestChunkOffsets(4), chunks));
+  EXPECT_TRUE(ReadSTSC({1, 1, 1, 3, 1, 1, 2, 1, 1})
+                  ->GetChunks(TestChunkOffsets(4), chunks));
+
+  // more samples than can be numbered
+  EXPECT_TRUE(ReadSTSC({1, 0x80000000, 1})
+                  ->GetChunks(TestChunkOffsets(2), chunks));
+  EXPECT_TRUE(chunks.empty());
+}
+} // namespace ISOBMFF
@@ -84,6 +84,10 @@ TEST_F(ISOBMFFSTSDTest, TestSTSDParser) {
     const std::string type = subbox->GetName();
     if (type == "hvc1") {
       SUCCEED() << "Found expected hvc1 box";
+      // located after the version, flags and entry count
+      EXPECT_EQ(subbox->GetOffset(), 8);
+      EXPECT_EQ(subbox->GetHeaderSize(), 8);
+      EXPECT_EQ(subbox->GetSize(), 0xdd);
   } else {
       FAIL() << "Unexpected sub-box type: " << type;
   }
@@ -54,4 +54,80 @@ TEST_F(ISOBMFFSTSSTest, TestSTSSParser) {
   EXPECT_EQ(stss->GetSampleNumber(0), 1);
   EXPECT_EQ(stss->GetSampleNumber(1), 31);
 }
+
+static std::vector<uint8_t> MakeSTSS(const std::vector<uint32_t> &numbers) {
+  std::vector<uint32_t> values = {0, static_cast<uint32_t>(numbers.size())};
+  values.insert(values.end(), numbers.begin(), numbers.end());
+  std::vector<uint8_t> buffer;
+  for (uint32_t value : values) {
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value));
+  }
+  return buffer;
+}
+
+TEST_F(ISOBMFFSTSSTest, TestSyncSamples) {
+  const std::vector<uint8_t> &buffer = MakeSTSS({1, 31, 61, 200});
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  ISOBMFF::STSS stss;
+  ASSERT_FALSE(stss.ReadData(parser, stream));
+
+  // samples are numbered from 0
+  EXPECT_TRUE(stss.IsSyncSample(0));
+  EXPECT_FALSE(stss.IsSyncSample(1));
+  EXPECT_TRUE(stss.IsSyncSample(30));
+  EXPECT_TRUE(stss.IsSyncSample(199));
+  EXPECT_FALSE(stss.IsSyncSample(200));
+  EXPECT_FALSE(stss.IsSyncSample(UINT64_MAX));
+
+  uint64_t sync = 0;
+  EXPECT_TRUE(stss.GetPreviousSyncSample(45, sync));
+  EXPECT_EQ(sync, 30);
+  EXPECT_TRUE(stss.GetPreviousSyncSample(60, sync));
+  EXPECT_EQ(sync, 60);
+  EXPECT_TRUE(stss.GetPreviousSyncSample(UINT64_MAX, sync));
+  EXPECT_EQ(sync, 199);
+  EXPECT_TRUE(stss.GetNextSyncSample(45, sync));
+  EXPECT_EQ(sync, 60);
+  EXPECT_TRUE(stss.GetNextSyncSample(0, sync));
+  EXPECT_EQ(sync, 0);
+  EXPECT_FALSE(stss.GetNextSyncSample(200, sync));
+  EXPECT_FALSE(stss.GetNextSyncSample(UINT64_MAX, sync));
+
+  // unordered entries, and entries too large for a bitset
+  const std::vector<uint8_t> &unordered =
+      MakeSTSS({0, 4000000000u, 61, 11, 61});
+  ISOBMFF::BinaryDataStream other(unordered);
+  ASSERT_FALSE(stss.ReadData(parser, other));
+  EXPECT_EQ(stss.GetEntryCount(), 5);
+  EXPECT_FALSE(stss.IsSyncSample(0));
+  EXPECT_TRUE(stss.IsSyncSample(10));
+  EXPECT_TRUE(stss.IsSyncSample(3999999999u));
+  EXPECT_FALSE(stss.GetPreviousSyncSample(9, sync));
+  EXPECT_TRUE(stss.GetPreviousSyncSample(100, sync));
+  EXPECT_EQ(sync, 60);
+  EXPECT_TRUE(stss.GetNextSyncSample(61, sync));
+  EXPECT_EQ(sync, 3999999999u);
+
+  // entries too sparse for a bitset
+  for (uint32_t number : {256u, 257u, 67108863u}) {
+    const std::vector<uint8_t> &sparse = MakeSTSS({number});
+    ISOBMFF::BinaryDataStream stream(sparse);
+    ASSERT_FALSE(stss.ReadData(parser, stream));
+    EXPECT_TRUE(stss.IsSyncSample(number - 1));
+    EXPECT_FALSE(stss.IsSyncSample(number - 2));
+    EXPECT_FALSE(stss.IsSyncSample(number));
+    EXPECT_TRUE(stss.GetPreviousSyncSample(number + 10, sync));
+    EXPECT_EQ(sync, number - 1);
+  }
+
+  // no entries
+  ISOBMFF::STSS empty;
+  EXPECT_FALSE(empty.IsSyncSample(0));
+  EXPECT_FALSE(empty.GetPreviousSyncSample(10, sync));
+  EXPECT_FALSE(empty.GetNextSyncSample(0, sync));
+}
 } // namespace ISOBMFF
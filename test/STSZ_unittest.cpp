@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+
+#include <ISOBMFF.hpp>                  // for various
+#include <BinaryDataStream.hpp> // for BinaryDataStream
+#include <Parser.hpp>           // for Parser
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFSTSZTest : public ::testing::Test {
+public:
+  ISOBMFFSTSZTest() {}
+  ~ISOBMFFSTSZTest() override {}
+};
+
+TEST_F(ISOBMFFSTSZTest, TestSTSZParser) {
+  // fuzzer::conv: data
+  const std::vector<uint8_t> &buffer = {
+      // stsz size: 32 bytes
+      // 0x00, 0x00, 0x00, 0x20,
+      // stsz
+      // 0x73, 0x74, 0x73, 0x7a,
+      // stsz content:
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x2c, 0x4f,
+      0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 0x8a
+  };
+
+  // fuzzer::conv: begin
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  std::shared_ptr<ISOBMFF::Box> box = parser.CreateBox("stsz");
+
+  ISOBMFF::Error error;
+  if (box != nullptr) {
+    error = box->ReadData(parser, stream);
+  }
+  if (error) {
+    fprintf(stderr, "Parse error: %s\n", error.GetMessage().c_str());
+  }
+  // fuzzer::conv: end
+
+  // Validate STSZ box
+  auto stsz = std::dynamic_pointer_cast<ISOBMFF::STSZ>(box);
+  ASSERT_NE(stsz, nullptr) << "Failed to cast to STSZ";
+
+  // Validate sample sizes
+  EXPECT_EQ(stsz->GetSampleSize(), 0);
+  EXPECT_EQ(stsz->GetSampleCount(), 3);
+  EXPECT_EQ(stsz->GetSampleSize(0), 76879);
+  EXPECT_EQ(stsz->GetSampleSize(1), 259);
+  EXPECT_EQ(stsz->GetSampleSize(2), 138);
+}
+
+TEST_F(ISOBMFFSTSZTest, TestConstantSampleSize) {
+  // constant sizes have no table
+  const std::vector<uint8_t> &buffer = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+      0x00, 0x03, 0x4b, 0xc0
+  };
+
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  ISOBMFF::STSZ stsz;
+  ASSERT_FALSE(stsz.ReadData(parser, stream));
+  EXPECT_EQ(stsz.GetSampleSize(), 512);
+  EXPECT_EQ(stsz.GetSampleCount(), 216000);
+  EXPECT_EQ(stsz.GetSampleSize(0), 512);
+  EXPECT_EQ(stsz.GetSampleSize(215999), 512);
+
+  // tables larger than the box
+  const std::vector<uint8_t> &truncated = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01
+  };
+  ISOBMFF::BinaryDataStream other(truncated);
+  ISOBMFF::STSZ invalid;
+  EXPECT_TRUE(invalid.ReadData(parser, other));
+}
+} // namespace ISOBMFF
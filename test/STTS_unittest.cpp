@@ -79,4 +79,55 @@ TEST_F(ISOBMFFSTTSTest, TestSTTSParser) {
   EXPECT_EQ(stts->GetSampleCount(8), 3);
   EXPECT_EQ(stts->GetSampleOffset(8), 3007);
 }
+
+TEST_F(ISOBMFFSTTSTest, TestSeek) {
+  const std::vector<uint8_t> &buffer = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+      0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0a,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63,
+      0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x05
+  };
+
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  ISOBMFF::STTS stts;
+  ASSERT_FALSE(stts.ReadData(parser, stream));
+  EXPECT_EQ(stts.GetTotalSampleCount(), 6);
+  EXPECT_EQ(stts.GetDuration(), 25);
+
+  // samples past the last one start at the end
+  const uint64_t dts[] = {0, 10, 20, 20, 20, 20, 25, 25};
+  for (uint64_t sample = 0; sample < 8; sample++) {
+    EXPECT_EQ(stts.GetDecodingTime(sample), dts[sample]);
+  }
+  EXPECT_EQ(stts.GetDecodingTime(UINT64_MAX), 25);
+
+  // samples without a duration cover no time
+  const uint64_t times[] = {0, 9, 10, 19, 20, 24, 25, 1000};
+  const uint64_t samples[] = {0, 0, 1, 1, 5, 5, 6, 6};
+  for (size_t i = 0; i < 8; i++) {
+    EXPECT_EQ(stts.GetSampleAtTime(times[i]), samples[i]);
+  }
+
+  // copies, and boxes read again, have their own index
+  ISOBMFF::STTS copy(stts);
+  EXPECT_EQ(copy.GetSampleAtTime(12), 1);
+  const std::vector<uint8_t> &data = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+      0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x01
+  };
+  ISOBMFF::BinaryDataStream other(data);
+  ASSERT_FALSE(stts.ReadData(parser, other));
+  EXPECT_EQ(stts.GetTotalSampleCount(), 100);
+  EXPECT_EQ(stts.GetDecodingTime(42), 42);
+  EXPECT_EQ(stts.GetSampleAtTime(42), 42);
+  EXPECT_EQ(copy.GetDuration(), 25);
+
+  // no entries
+  ISOBMFF::STTS empty;
+  EXPECT_EQ(empty.GetTotalSampleCount(), 0);
+  EXPECT_EQ(empty.GetDecodingTime(3), 0);
+  EXPECT_EQ(empty.GetSampleAtTime(3), 0);
+}
 } // namespace ISOBMFF
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+
+#include <ISOBMFF.hpp>                  // for various
+#include <BinaryDataStream.hpp> // for BinaryDataStream
+#include <Parser.hpp>           // for Parser
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFSTZ2Test : public ::testing::Test {
+public:
+  ISOBMFFSTZ2Test() {}
+  ~ISOBMFFSTZ2Test() override {}
+};
+
+TEST_F(ISOBMFFSTZ2Test, TestSTZ2Parser) {
+  // fuzzer::conv: data
+  const std::vector<uint8_t> &buffer = {
+      // stz2 size: 23 bytes
+      // 0x00, 0x00, 0x00, 0x17,
+      // stz2
+      // 0x73, 0x74, 0x7a, 0x32,
+      // stz2 content:
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+      0x00, 0x00, 0x00, 0x05, 0x1f, 0x80, 0x70
+  };
+
+  // fuzzer::conv: begin
+  ISOBMFF::BinaryDataStream stream(buffer);
+  ISOBMFF::Parser parser;
+  std::shared_ptr<ISOBMFF::Box> box = parser.CreateBox("stz2");
+
+  ISOBMFF::Error error;
+  if (box != nullptr) {
+    error = box->ReadData(parser, stream);
+  }
+  if (error) {
+    fprintf(stderr, "Parse error: %s\n", error.GetMessage().c_str());
+  }
+  // fuzzer::conv: end
+
+  // Validate STZ2 box
+  auto stz2 = std::dynamic_pointer_cast<ISOBMFF::STZ2>(box);
+  ASSERT_NE(stz2, nullptr) << "Failed to cast to STZ2";
+
+  // Validate 4-bit sample sizes
+  EXPECT_EQ(stz2->GetFieldSize(), 4);
+  EXPECT_EQ(stz2->GetSampleCount(), 5);
+  EXPECT_EQ(stz2->GetSampleSize(0), 1);
+  EXPECT_EQ(stz2->GetSampleSize(1), 15);
+  EXPECT_EQ(stz2->GetSampleSize(2), 8);
+  EXPECT_EQ(stz2->GetSampleSize(3), 0);
+  EXPECT_EQ(stz2->GetSampleSize(4), 7);
+}
+
+TEST_F(ISOBMFFSTZ2Test, TestFieldSizes) {
+  ISOBMFF::Parser parser;
+
+  // 8-bit sizes
+  const std::vector<uint8_t> &buffer8 = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+      0x00, 0x00, 0x00, 0x02, 0xff, 0x10
+  };
+  ISOBMFF::BinaryDataStream stream8(buffer8);
+  ISOBMFF::STZ2 stz8;
+  ASSERT_FALSE(stz8.ReadData(parser, stream8));
+  EXPECT_EQ(stz8.GetSampleCount(), 2);
+  EXPECT_EQ(stz8.GetSampleSize(0), 255);
+  EXPECT_EQ(stz8.GetSampleSize(1), 16);
+
+  // 16-bit sizes, big-endian
+  const std::vector<uint8_t> &buffer16 = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+      0x00, 0x00, 0x00, 0x02, 0x12, 0x34, 0xff, 0xfe
+  };
+  ISOBMFF::BinaryDataStream stream16(buffer16);
+  ISOBMFF::STZ2 stz16;
+  ASSERT_FALSE(stz16.ReadData(parser, stream16));
+  EXPECT_EQ(stz16.GetSampleSize(0), 0x1234);
+  EXPECT_EQ(stz16.GetSampleSize(1), 0xfffe);
+
+  // field sizes other than 4, 8 and 16 are invalid
+  const std::vector<uint8_t> &invalid = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20,
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01
+  };
+  ISOBMFF::BinaryDataStream streamInvalid(invalid);
+  ISOBMFF::STZ2 stzInvalid;
+  EXPECT_TRUE(stzInvalid.ReadData(parser, streamInvalid));
+
+  // tables larger than the box
+  const std::vector<uint8_t> &truncated = {
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+      0x00, 0x00, 0x00, 0x02, 0x12, 0x34, 0xff
+  };
+  ISOBMFF::BinaryDataStream streamTruncated(truncated);
+  ISOBMFF::STZ2 stzTruncated;
+  EXPECT_TRUE(stzTruncated.ReadData(parser, streamTruncated));
+}
+} // namespace ISOBMFF
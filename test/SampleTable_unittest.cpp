@@ -0,0 +1,277 @@
+/*
+ *  Copyright (c) Meta Platforms, Inc. and its affiliates.
+ */
+#include <ISOBMFF.hpp>       // for various
+#include <SampleTable.hpp>   // for SampleTable
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace ISOBMFF {
+
+class ISOBMFFSampleTableTest : public ::testing::Test {
+public:
+  ISOBMFFSampleTableTest() {}
+  ~ISOBMFFSampleTableTest() override {}
+};
+
+static void AppendUInt32(std::vector<uint8_t> &data, uint32_t value) {
+  data.push_back(static_cast<uint8_t>(value >> 24));
+  data.push_back(static_cast<uint8_t>(value >> 16));
+  data.push_back(static_cast<uint8_t>(value >> 8));
+  data.push_back(static_cast<uint8_t>(value));
+}
+
+// a box, with its header
+static std::vector<uint8_t> MakeBox(const std::string &type,
+                                    const std::vector<uint8_t> &content) {
+  std::vector<uint8_t> box;
+  AppendUInt32(box, static_cast<uint32_t>(content.size() + 8));
+  box.insert(box.end(), type.begin(), type.end());
+  box.insert(box.end(), content.begin(), content.end());
+  return box;
+}
+
+// a full box, with version and flags 0, holding 32-bit values
+static std::vector<uint8_t> MakeFullBox(const std::string &type,
+                                        const std::vector<uint32_t> &values) {
+  std::vector<uint8_t> content;
+  AppendUInt32(content, 0);
+  for (uint32_t value : values) {
+    AppendUInt32(content, value);
+  }
+  return MakeBox(type, content);
+}
+
+// reads a trak box holding the given stbl boxes, in a file of the given size
+static Error ReadTrack(const std::vector<std::vector<uint8_t> > &boxes,
+                       SampleTable &table, uint64_t fileSize = UINT64_MAX) {
+  std::vector<uint8_t> stbl;
+  for (const auto &box : boxes) {
+    stbl.insert(stbl.end(), box.begin(), box.end());
+  }
+  std::vector<uint8_t> data =
+      MakeBox("mdia", MakeBox("minf", MakeBox("stbl", stbl)));
+
+  ISOBMFF::BinaryDataStream stream(data);
+  ISOBMFF::Parser parser;
+  ISOBMFF::ContainerBox trak("trak");
+  EXPECT_FALSE(trak.ReadData(parser, stream));
+  return table.Read(trak, fileSize);
+}
+
+static std::vector<std::shared_ptr<Box> > GetTracks(const Container &moov) {
+  return moov.GetBoxes("trak");
+}
+
+TEST_F(ISOBMFFSampleTableTest, TestSamples) {
+  // 5 samples, in 3 chunks of 2, 1 and 2 samples
+  std::vector<uint8_t> co64;
+  AppendUInt32(co64, 0);
+  AppendUInt32(co64, 3);
+  for (uint32_t value : {1u, 0u, 0u, 1000u, 0u, 2000u}) {
+    AppendUInt32(co64, value);
+  }
+  const std::vector<std::vector<uint8_t> > boxes = {
+      MakeFullBox("stsz", {0, 5, 10, 20, 30, 40, 50}),
+      MakeFullBox("stts", {2, 3, 100, 2, 200}),
+      MakeFullBox("ctts", {2, 1, 200, 1, static_cast<uint32_t>(-100)}),
+      MakeFullBox("stss", {2, 1, 4}),
+      MakeFullBox("stsc", {3, 1, 2, 1, 2, 1, 1, 3, 2, 1}),
+      MakeBox("co64", co64)};
+
+  ISOBMFF::SampleTable table;
+  ASSERT_FALSE(ReadTrack(boxes, table));
+  ASSERT_EQ(table.GetSampleCount(), 5);
+
+  const uint64_t offset[] = {0x100000000, 0x10000000a, 1000, 2000, 2040};
+  const uint32_t size[] = {10, 20, 30, 40, 50};
+  const uint64_t dts[] = {0, 100, 200, 300, 500};
+  const int64_t cts[] = {200, 0, 200, 300, 500};
+  const bool sync[] = {true, false, false, true, false};
+  for (size_t i = 0; i < table.GetSampleCount(); i++) {
+    EXPECT_EQ(table.GetSampleOffset(i), offset[i]);
+    EXPECT_EQ(table.GetSampleSize(i), size[i]);
+    EXPECT_EQ(table.GetDecodingTime(i), dts[i]);
+    EXPECT_EQ(table.GetCompositionTime(i), cts[i]);
+    EXPECT_EQ(table.IsSyncSample(i), sync[i]);
+  }
+
+  // sync samples at or around a sample
+  size_t found = 0;
+  EXPECT_TRUE(table.GetPreviousSyncSample(2, found));
+  EXPECT_EQ(found, 0);
+  EXPECT_TRUE(table.GetNextSyncSample(2, found));
+  EXPECT_EQ(found, 3);
+  EXPECT_TRUE(table.GetPreviousSyncSample(4, found));
+  EXPECT_EQ(found, 3);
+  EXPECT_FALSE(table.GetNextSyncSample(4, found));
+  EXPECT_FALSE(table.GetPreviousSyncSample(5, found));
+
+  // without ctts and stss, times are decoding times and all samples sync
+  ISOBMFF::SampleTable other;
+  ASSERT_FALSE(ReadTrack({MakeFullBox("stsz", {4, 3}),
+                          MakeFullBox("stts", {1, 3, 10}),
+                          MakeFullBox("stsc", {1, 1, 3, 1}),
+                          MakeFullBox("stco", {1, 48})},
+                         other));
+  ASSERT_EQ(other.GetSampleCount(), 3);
+  EXPECT_EQ(other.GetSampleOffset(2), 56);
+  EXPECT_EQ(other.GetSampleSize(2), 4);
+  EXPECT_EQ(other.GetCompositionTime(2), 20);
+  EXPECT_TRUE(other.IsSyncSample(1));
+  EXPECT_TRUE(other.GetPreviousSyncSample(1, found));
+  EXPECT_EQ(found, 1);
+  EXPECT_TRUE(other.GetNextSyncSample(2, found));
+  EXPECT_EQ(found, 2);
+  EXPECT_FALSE(other.GetNextSyncSample(3, found));
+}
+
+TEST_F(ISOBMFFSampleTableTest, TestInvalidSamples) {
+  const std::vector<uint8_t> stsz = MakeFullBox("stsz", {4, 3});
+  const std::vector<uint8_t> stts = MakeFullBox("stts", {1, 3, 10});
+  const std::vector<uint8_t> stsc = MakeFullBox("stsc", {1, 1, 3, 1});
+  const std::vector<uint8_t> stco = MakeFullBox("stco", {1, 48});
+  ISOBMFF::SampleTable table;
+
+  // missing tables
+  EXPECT_TRUE(ReadTrack({stts, stsc, stco}, table));
+  EXPECT_TRUE(ReadTrack({stsz, stsc, stco}, table));
+  EXPECT_TRUE(ReadTrack({stsz, stts, stco}, table));
+  EXPECT_TRUE(ReadTrack({stsz, stts, stsc}, table));
+  ISOBMFF::ContainerBox trak("trak");
+  EXPECT_TRUE(table.Read(trak, UINT64_MAX));
+
+  // samples without times or chunks
+  EXPECT_TRUE(ReadTrack(
+      {stsz, MakeFullBox("stts", {1, 2, 10}), stsc, stco}, table));
+  EXPECT_TRUE(ReadTrack(
+      {stsz, stts, MakeFullBox("stsc", {1, 1, 2, 1}), stco}, table));
+
+  // too many samples
+  EXPECT_TRUE(ReadTrack({MakeFullBox("stsz", {4, 0xffffffff}), stts, stsc,
+                         stco},
+                        table));
+  const uint32_t max =
+      static_cast<uint32_t>(ISOBMFF::SampleTable::DefaultMaxSampleCount);
+  EXPECT_TRUE(ReadTrack({MakeFullBox("stsz", {1, max + 1}),
+                         MakeFullBox("stts", {1, max + 1, 1}),
+                         MakeFullBox("stsc", {1, 1, max + 1, 1}), stco},
+                        table));
+
+  // run-length tables describing more samples than the file holds
+  EXPECT_TRUE(ReadTrack({MakeFullBox("stsz", {1, max}),
+                         MakeFullBox("stts", {1, max, 1}),
+                         MakeFullBox("stsc", {1, 1, max, 1}), stco},
+                        table, 116));
+
+  // tables are kept on error
+  ASSERT_FALSE(ReadTrack({stsz, stts, stsc, stco}, table));
+  EXPECT_TRUE(ReadTrack({stsz}, table));
+  EXPECT_EQ(table.GetSampleCount(), 3);
+
+  // samples past the end of the file
+  EXPECT_TRUE(ReadTrack({stsz, stts, stsc, stco}, table, 59));
+  EXPECT_FALSE(ReadTrack({stsz, stts, stsc, stco}, table, 60));
+  const std::vector<uint8_t> sizes = MakeFullBox("stsz", {0, 3, 4, 4, 5});
+  EXPECT_TRUE(ReadTrack({sizes, stts, stsc, stco}, table, 60));
+  EXPECT_FALSE(ReadTrack({sizes, stts, stsc, stco}, table, 61));
+  EXPECT_TRUE(ReadTrack({stsz, stts, stsc, MakeFullBox("stco", {1, 61})},
+                        table, 60));
+
+  // empty tracks need no tables
+  ASSERT_FALSE(ReadTrack({MakeFullBox("stsz", {0, 0})}, table));
+  EXPECT_EQ(table.GetSampleCount(), 0);
+}
+
+TEST_F(ISOBMFFSampleTableTest, TestMaxSampleCount) {
+  const std::vector<std::vector<uint8_t> > boxes = {
+      MakeFullBox("stsz", {4, 3}), MakeFullBox("stts", {1, 3, 10}),
+      MakeFullBox("stsc", {1, 1, 3, 1}), MakeFullBox("stco", {1, 48})};
+
+  ISOBMFF::SampleTable table;
+  EXPECT_EQ(table.GetMaxSampleCount(),
+            ISOBMFF::SampleTable::DefaultMaxSampleCount);
+  table.SetMaxSampleCount(2);
+  EXPECT_EQ(table.GetMaxSampleCount(), 2);
+  EXPECT_TRUE(ReadTrack(boxes, table));
+
+  // the limit is kept by copies and reads
+  ISOBMFF::SampleTable copy(table);
+  EXPECT_EQ(copy.GetMaxSampleCount(), 2);
+  copy.SetMaxSampleCount(3);
+  ASSERT_FALSE(ReadTrack(boxes, copy));
+  EXPECT_EQ(copy.GetSampleCount(), 3);
+  EXPECT_EQ(copy.GetMaxSampleCount(), 3);
+  EXPECT_EQ(table.GetMaxSampleCount(), 2);
+}
+
+TEST_F(ISOBMFFSampleTableTest, TestFile) {
+  const std::string path = std::string(TEST_MEDIA_DIR) + "/MOV1.MOV";
+  ISOBMFF::Parser parser;
+  ASSERT_FALSE(parser.Parse(path));
+  const uint64_t size = ISOBMFF::BinaryFileStream(path).Size();
+  std::shared_ptr<ContainerBox> moov =
+      parser.GetFile()->GetTypedBox<ContainerBox>("moov");
+  ASSERT_NE(moov, nullptr);
+
+  ISOBMFF::Parser lazy;
+  lazy.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+  ASSERT_FALSE(lazy.Parse(path));
+  std::vector<std::shared_ptr<Box> > lazyTracks =
+      GetTracks(*(lazy.GetFile()->GetTypedBox<ContainerBox>("moov")));
+
+  std::vector<std::shared_ptr<Box> > tracks = GetTracks(*(moov));
+  ASSERT_EQ(tracks.size(), 4);
+  ASSERT_EQ(lazyTracks.size(), tracks.size());
+  for (size_t i = 0; i < tracks.size(); i++) {
+    auto trak = std::dynamic_pointer_cast<ContainerBox>(tracks[i]);
+    auto stbl = trak->GetTypedBox<ContainerBox>("mdia")
+                    ->GetTypedBox<ContainerBox>("minf")
+                    ->GetTypedBox<ContainerBox>("stbl");
+    auto stsz = stbl->GetTypedBox<STSZ>("stsz");
+    auto stts = stbl->GetTypedBox<STTS>("stts");
+    auto stco = stbl->GetTypedBox<STCO>("stco");
+    ASSERT_NE(stsz, nullptr);
+    ASSERT_NE(stts, nullptr);
+    ASSERT_NE(stco, nullptr);
+
+    // the media data was cut from the file, leaving only its tables
+    ISOBMFF::SampleTable table;
+    EXPECT_TRUE(table.Read(*(trak), size));
+    ASSERT_FALSE(table.Read(*(trak), UINT64_MAX));
+    ASSERT_EQ(table.GetSampleCount(), stsz->GetSampleCount());
+    ASSERT_GT(table.GetSampleCount(), 0);
+
+    // samples follow each other, in the first chunk
+    EXPECT_EQ(table.GetSampleOffset(0), stco->GetChunkOffset(0));
+    uint64_t duration = 0;
+    for (size_t j = 0; j < stts->GetEntryCount(); j++) {
+      duration += uint64_t(stts->GetSampleCount(j)) * stts->GetSampleOffset(j);
+    }
+    size_t last = table.GetSampleCount() - 1;
+    EXPECT_EQ(table.GetDecodingTime(last) +
+                  stts->GetSampleOffset(stts->GetEntryCount() - 1),
+              duration);
+    for (size_t j = 0; j < table.GetSampleCount(); j++) {
+      EXPECT_EQ(table.GetSampleSize(j), stsz->GetSampleSize(j));
+    }
+    EXPECT_TRUE(table.IsSyncSample(0));
+
+    // deferred boxes are read as needed
+    ISOBMFF::SampleTable other;
+    auto lazyTrak = std::dynamic_pointer_cast<ContainerBox>(lazyTracks[i]);
+    ASSERT_FALSE(other.Read(*(lazyTrak), UINT64_MAX));
+    ASSERT_EQ(other.GetSampleCount(), table.GetSampleCount());
+    for (size_t j = 0; j < table.GetSampleCount(); j++) {
+      EXPECT_EQ(other.GetSampleOffset(j), table.GetSampleOffset(j));
+      EXPECT_EQ(other.GetCompositionTime(j), table.GetCompositionTime(j));
+      EXPECT_EQ(other.IsSyncSample(j), table.IsSyncSample(j));
+    }
+  }
+}
+
+}  // namespace ISOBMFF
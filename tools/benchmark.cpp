@@ -0,0 +1,495 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        benchmark.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <getopt.h>
+
+#include <ISOBMFF.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+/* option values */
+typedef struct arg_options {
+  int debug;
+  int iterations;
+  int threads;
+  std::vector<char *> infiles;
+} arg_options;
+
+/* default option values */
+static arg_options DEFAULT_OPTIONS{
+    .debug = 0,
+    .iterations = 100,
+    .threads = 0,
+    .infiles = std::vector<char *>(),
+};
+
+void usage(char *name) {
+  fprintf(stderr, "usage: %s [options]\n", name);
+  fprintf(stderr, "where options are:\n");
+  fprintf(stderr, "\t-d:\t\tIncrease debug verbosity [%i]\n",
+          DEFAULT_OPTIONS.debug);
+  fprintf(stderr, "\t-q:\t\tZero debug verbosity\n");
+  fprintf(stderr, "\t-n <iterations>:\tIterations per measurement [%i]\n",
+          DEFAULT_OPTIONS.iterations);
+  fprintf(stderr,
+          "\t-t <threads>:\tThreads for parallel decoding, 0 for the "
+          "default pool [%i]\n",
+          DEFAULT_OPTIONS.threads);
+  fprintf(stderr, "\tinfile [infile]+:\t\tSelect infiles\n");
+  fprintf(stderr, "\t-h:\t\tHelp\n");
+  exit(-1);
+}
+
+// long options with no equivalent short option
+enum {
+  QUIET_OPTION = CHAR_MAX + 1,
+  HELP_OPTION,
+};
+
+arg_options *parse_args(int argc, char *const *argv) {
+  int c;
+  static arg_options options;
+
+  // set default option values
+  options = DEFAULT_OPTIONS;
+
+  // getopt_long stores the option index here
+  int optindex = 0;
+
+  // long options
+  static struct option longopts[] = {
+      // matching options to short options
+      {"debug", no_argument, nullptr, 'd'},
+      {"iterations", required_argument, nullptr, 'n'},
+      {"threads", required_argument, nullptr, 't'},
+      // options without a short option
+      {"quiet", no_argument, nullptr, QUIET_OPTION},
+      {"help", no_argument, nullptr, HELP_OPTION},
+      {nullptr, 0, nullptr, 0}};
+
+  // parse arguments
+  while (true) {
+    c = getopt_long(argc, argv, "dn:t:h", longopts, &optindex);
+    if (c == -1) {
+      break;
+    }
+    switch (c) {
+      case 'd':
+        options.debug += 1;
+        break;
+
+      case 'n':
+        options.iterations = atoi(optarg);
+        break;
+
+      case 't':
+        options.threads = atoi(optarg);
+        break;
+
+      case QUIET_OPTION:
+        options.debug = 0;
+        break;
+
+      case HELP_OPTION:
+      case 'h':
+        usage(argv[0]);
+        break;
+
+      default:
+        printf("Unsupported option: %c\n", c);
+        usage(argv[0]);
+    }
+  }
+
+  // remaining arguments are infiles
+  for (int i = optind; i < argc; ++i) {
+    options.infiles.push_back(argv[i]);
+  }
+
+  if (options.iterations <= 0 || options.threads < 0) {
+    return nullptr;
+  }
+
+  return &options;
+}
+
+// runs a measurement, and returns the average time per iteration (usec)
+static double measure(int iterations, const std::function<bool()> &run) {
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; i++) {
+    if (run() == false) {
+      return -1.0;
+    }
+  }
+
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  return elapsed.count() / iterations;
+}
+
+static void report(const std::string &name, const std::string &what,
+                   double usec) {
+  if (usec < 0) {
+    printf("%-32s %-24s %12s\n", name.c_str(), what.c_str(), "error");
+  } else {
+    printf("%-32s %-24s %12.2f us\n", name.c_str(), what.c_str(), usec);
+  }
+}
+
+static void report_io(const std::string &name, size_t bufferSize) {
+  ISOBMFF::BinaryFileStream stream(name, bufferSize);
+  ISOBMFF::Parser parser;
+  std::string what = "io (buffer " + std::to_string(bufferSize) + ")";
+
+  if (parser.Parse(stream)) {
+    printf("%-32s %-24s %12s\n", name.c_str(), what.c_str(), "error");
+    return;
+  }
+
+  printf("%-32s %-24s %8llu reads %10llu bytes\n", name.c_str(), what.c_str(),
+         static_cast<unsigned long long>(stream.GetReadCount()),
+         static_cast<unsigned long long>(stream.GetBytesRead()));
+}
+
+// stops with the first sample description, as a player probing a movie
+class FirstSampleDescriptionVisitor : public ISOBMFF::BoxVisitor {
+ public:
+  Action VisitBox(const std::shared_ptr<ISOBMFF::Box> &box) override {
+    return (box->GetName() == "stsd") ? Action::Stop : Action::Continue;
+  }
+};
+
+static void benchmark_file(const std::string &path, int iterations,
+                           int threads) {
+  std::ifstream stream(path, std::ios::binary);
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(stream)),
+                            std::istreambuf_iterator<char>());
+  ISOBMFF::Parser parser;
+
+  report(path, "parse (mapped file)", measure(iterations, [&]() {
+           return !parser.Parse(path);
+         }));
+
+  parser.AddOption(ISOBMFF::Parser::Options::DoNotMapFiles);
+  report(path, "parse (file stream)", measure(iterations, [&]() {
+           return !parser.Parse(path);
+         }));
+  parser.RemoveOption(ISOBMFF::Parser::Options::DoNotMapFiles);
+
+  report(path, "parse (memory)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size());
+         }));
+
+  parser.AddOption(ISOBMFF::Parser::Options::ArenaAllocation);
+  report(path, "parse (memory, arena)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size());
+         }));
+  parser.RemoveOption(ISOBMFF::Parser::Options::ArenaAllocation);
+
+  // the default pool has a single thread on single-core hosts, where
+  // boxes are then read in order
+  if (threads > 0) {
+    parser.SetThreadPool(std::make_shared<ISOBMFF::ThreadPool>(threads));
+  }
+  parser.AddOption(ISOBMFF::Parser::Options::ParallelDecoding);
+  report(path, "parse (mapped, parallel)", measure(iterations, [&]() {
+           return !parser.Parse(path);
+         }));
+  report(path, "parse (memory, parallel)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size());
+         }));
+  parser.RemoveOption(ISOBMFF::Parser::Options::ParallelDecoding);
+  parser.SetThreadPool(nullptr);
+
+  // only the sample tables, and the item locations
+  parser.AllowBoxPath("moov/trak/mdia/minf/stbl");
+  parser.AllowBoxPath("meta/iloc");
+  report(path, "parse (memory, filtered)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size());
+         }));
+  parser.ClearBoxPaths();
+
+  // data received in chunks, as from a network upload
+  report(path, "parse (incremental)", measure(iterations, [&]() {
+           ISOBMFF::IncrementalParser incremental(parser);
+           const size_t chunk = 4096;
+           for (size_t i = 0; i < data.size(); i += chunk) {
+             if (incremental.Append(data.data() + i,
+                                    std::min(chunk, data.size() - i))) {
+               return false;
+             }
+           }
+           return !incremental.Finish();
+         }));
+
+  std::vector<ISOBMFF::Parser::BoxMapEntry> boxes;
+  report(path, "scan (memory)", measure(iterations, [&]() {
+           return !parser.Scan(data.data(), data.size(), boxes);
+         }));
+
+  // visiting decodes every box, but keeps none of them
+  ISOBMFF::BoxVisitor visitor;
+  report(path, "visit (memory)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size(), visitor);
+         }));
+
+  FirstSampleDescriptionVisitor first;
+  report(path, "visit (memory, stop)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size(), first);
+         }));
+
+  // probing reads the brand, the primary item and its location only
+  auto probe = [&]() {
+    std::shared_ptr<ISOBMFF::File> file = parser.GetFile();
+    std::shared_ptr<ISOBMFF::META> meta;
+
+    if (file == nullptr ||
+        file->GetTypedBox<ISOBMFF::FTYP>("ftyp") == nullptr) {
+      return false;
+    }
+
+    meta = file->GetTypedBox<ISOBMFF::META>("meta");
+
+    if (meta != nullptr) {
+      meta->GetTypedBox<ISOBMFF::PITM>("pitm");
+      meta->GetTypedBox<ISOBMFF::ILOC>("iloc");
+    }
+
+    return true;
+  };
+
+  report(path, "probe (memory)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size()) && probe();
+         }));
+
+  parser.AddOption(ISOBMFF::Parser::Options::LazyDecoding);
+  report(path, "probe (memory, lazy)", measure(iterations, [&]() {
+           return !parser.Parse(data.data(), data.size()) && probe();
+         }));
+  parser.RemoveOption(ISOBMFF::Parser::Options::LazyDecoding);
+
+  // expands the sample tables of each track, in movies
+  std::shared_ptr<ISOBMFF::ContainerBox> moov;
+
+  if (!parser.Parse(data.data(), data.size())) {
+    moov = parser.GetFile()->GetTypedBox<ISOBMFF::ContainerBox>("moov");
+  }
+
+  if (moov != nullptr) {
+    report(path, "sample tables", measure(iterations, [&]() {
+             for (const auto &box : moov->GetBoxes()) {
+               auto trak = std::dynamic_pointer_cast<ISOBMFF::Container>(box);
+               ISOBMFF::SampleTable table;
+               if (box->GetName() == "trak" && trak != nullptr &&
+                   table.Read(*(trak), data.size())) {
+                 return false;
+               }
+             }
+             return true;
+           }));
+  }
+
+  report_io(path, 0);
+  report_io(path, ISOBMFF::BinaryFileStream::DefaultBufferSize);
+}
+
+static void benchmark_parser(int iterations) {
+  const std::vector<std::string> types = {
+      "ftyp", "moov", "mvhd", "trak", "tkhd", "mdia", "mdhd", "hdlr",
+      "minf", "stbl", "stsd", "stts", "ctts", "stss", "meta", "iinf",
+      "infe", "iloc", "ipma", "hvcC", "stsz", "stco", "udta", "free"};
+  ISOBMFF::Parser parser;
+
+  report("Parser", "construction", measure(iterations * 100, []() {
+           ISOBMFF::Parser p;
+           return true;
+         }));
+
+  report("Parser", "copy", measure(iterations * 100, [&]() {
+           ISOBMFF::Parser p(parser);
+           return true;
+         }));
+
+  double usec = measure(iterations * 100, [&]() {
+    for (const auto &type : types) {
+      if (parser.CreateBox(type) == nullptr) {
+        return false;
+      }
+    }
+    return true;
+  });
+  report("Parser", "create box",
+         (usec < 0) ? usec : usec / static_cast<double>(types.size()));
+}
+
+// parses all the input files, one after the other and with a pool
+static void benchmark_batch(const std::vector<std::string> &paths,
+                            int iterations) {
+  ISOBMFF::Parser parser;
+  ISOBMFF::ParserPool pool(parser);
+  std::string name = "batch (" + std::to_string(paths.size()) + " files)";
+
+  report(name, "parse (serial)", measure(iterations, [&]() {
+           for (const auto &path : paths) {
+             if (parser.Parse(path)) return false;
+           }
+           return true;
+         }));
+
+  report(name, "parse (pool)", measure(iterations, [&]() {
+           std::atomic<bool> ok(true);
+           pool.Parse(paths, [&](size_t, const ISOBMFF::Error &err,
+                                 const std::shared_ptr<ISOBMFF::File> &) {
+             if (err) ok = false;
+           });
+           return ok.load();
+         }));
+}
+
+// decodes a synthetic sample table, as found in long high frame rate movies
+static void benchmark_sample_table(int iterations) {
+  const uint32_t entries = 500000;
+  std::vector<uint8_t> data = {0x00, 0x00, 0x00, 0x00,
+                               static_cast<uint8_t>(entries >> 24),
+                               static_cast<uint8_t>(entries >> 16),
+                               static_cast<uint8_t>(entries >> 8),
+                               static_cast<uint8_t>(entries)};
+
+  for (uint32_t i = 0; i < entries; i++) {
+    const uint8_t entry[8] = {0, 0, 0, static_cast<uint8_t>(1 + i % 3),
+                              0, 0, 0x03, 0xe9};
+    data.insert(data.end(), entry, entry + sizeof(entry));
+  }
+
+  ISOBMFF::Parser parser;
+  std::string name = "stts (" + std::to_string(entries) + " entries)";
+
+  report(name, "decode (per value)", measure(iterations, [&]() {
+           ISOBMFF::BinaryDataStream stream(data.data(), data.size());
+           std::vector<uint32_t> values;
+           uint32_t value;
+           for (size_t i = 0; i < data.size() / 4; i++) {
+             if (stream.ReadBigEndianUInt32(value)) return false;
+             values.push_back(value);
+           }
+           return true;
+         }));
+
+  report(name, "decode (array)", measure(iterations, [&]() {
+           ISOBMFF::BinaryDataStream stream(data.data(), data.size());
+           std::vector<uint32_t> values(data.size() / 4);
+           return !stream.ReadBigEndianUInt32Array(values.data(),
+                                                   values.size());
+         }));
+
+  report(name, "read box", measure(iterations, [&]() {
+           ISOBMFF::BinaryDataStream stream(data.data(), data.size());
+           return !parser.CreateBox("stts")->ReadData(parser, stream);
+         }));
+
+  // maps times spread over the whole track to samples, and reports the
+  // time per seek; linear scans are much slower, and are run less often
+  ISOBMFF::BinaryDataStream stream(data.data(), data.size());
+  ISOBMFF::STTS stts;
+  if (stts.ReadData(parser, stream)) {
+    return;
+  }
+  const uint64_t duration = stts.GetDuration();
+  const uint64_t seeks = 10;
+  uint64_t found = 0;
+
+  double usec = measure(std::max(1, iterations / 10), [&]() {
+    for (uint64_t i = 0; i < seeks; i++) {
+      uint64_t time = duration / seeks * i;
+      uint64_t start = 0;
+      for (size_t j = 0; j < stts.GetEntryCount(); j++) {
+        uint64_t run =
+            uint64_t(stts.GetSampleCount(j)) * stts.GetSampleOffset(j);
+        if (time < start + run) {
+          found += (time - start) / stts.GetSampleOffset(j);
+          break;
+        }
+        start += run;
+        found += stts.GetSampleCount(j);
+      }
+    }
+    return true;
+  });
+  report(name, "seek (linear)", (usec < 0) ? usec : usec / seeks);
+
+  usec = measure(iterations, [&]() {
+    for (uint64_t i = 0; i < seeks; i++) {
+      found += stts.GetSampleAtTime(duration / seeks * i);
+    }
+    return found != 0;
+  });
+  report(name, "seek (index)", (usec < 0) ? usec : usec / seeks);
+}
+
+int main(int argc, char *const *argv) {
+  arg_options *options;
+
+  // parse args
+  options = parse_args(argc, argv);
+  if (options == nullptr) {
+    usage(argv[0]);
+    exit(-1);
+  }
+  if (options->debug > 0) {
+    printf("options->debug = %i\n", options->debug);
+    printf("options->iterations = %i\n", options->iterations);
+    for (const auto &infile : options->infiles) {
+      printf("options->infile = %s\n", infile);
+    }
+  }
+
+  for (const auto &infile : options->infiles) {
+    benchmark_file(infile, options->iterations, options->threads);
+  }
+
+  benchmark_batch(std::vector<std::string>(options->infiles.begin(),
+                                           options->infiles.end()),
+                  options->iterations);
+  benchmark_parser(options->iterations);
+  benchmark_sample_table(options->iterations);
+
+  return EXIT_SUCCESS;
+}
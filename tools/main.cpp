@@ -30,11 +30,18 @@
 
 #include <getopt.h>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
 #include <ISOBMFF.hpp>
+#include <algorithm>
 #include <climits>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 /* option values */
@@ -61,7 +68,7 @@ void usage(char *name) {
           DEFAULT_OPTIONS.analyze_flag ? " [default]" : "");
   fprintf(stderr, "\t--no-analyze-flag:\tReset analyze flag%s\n",
           DEFAULT_OPTIONS.analyze_flag ? "" : " [default]");
-  fprintf(stderr, "\tinfile [infile]+:\t\tSelect infiles\n");
+  fprintf(stderr, "\tinfile [infile]+:\t\tSelect infiles (- for stdin)\n");
   fprintf(stderr, "\t-h:\t\tHelp\n");
   exit(-1);
 }
@@ -181,8 +188,59 @@ int main(int argc, char *const *argv) {
     return EXIT_FAILURE;
   }
 
-  for (const auto &infile : options->infiles) {
+  // several files are parsed concurrently, and then reported in order
+  std::vector<ISOBMFF::Error> errors;
+  std::vector<std::string> dumps;
+  bool batch = options->infiles.size() > 1 &&
+               std::none_of(options->infiles.begin(), options->infiles.end(),
+                            [](const char *infile) {
+                              return std::string(infile) == "-";
+                            });
+
+  if (batch) {
+    ISOBMFF::ParserPool pool(parser);
+    std::vector<std::string> paths(options->infiles.begin(),
+                                   options->infiles.end());
+
+    errors.resize(paths.size());
+    dumps.resize(paths.size());
+    pool.Parse(paths, [&](size_t i, const ISOBMFF::Error &err,
+                          const std::shared_ptr<ISOBMFF::File> &file) {
+      errors[i] = err;
+      if (options->analyze_flag && file != nullptr) {
+        std::ostringstream dump;
+        dump << *(file);
+        dumps[i] = dump.str();
+      }
+    });
+  }
+
+  for (size_t i = 0; i < options->infiles.size(); i++) {
+    const char *infile = options->infiles[i];
     path = infile;
+
+    // standard input may be a pipe, so it is read forward only
+    if (path == "-") {
+      ISOBMFF::IncrementalParser incremental(parser);
+
+#ifdef _WIN32
+      _setmode(_fileno(stdin), _O_BINARY);
+#endif
+
+      ISOBMFF::Error err = incremental.Append(std::cin);
+      if (!err) err = incremental.Finish();
+      if (err) {
+        std::cerr << "Parse error: " << err.GetMessage() << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      if (options->analyze_flag && incremental.GetFile() != nullptr) {
+        std::cout << *(incremental.GetFile()) << std::endl << std::endl;
+      }
+
+      continue;
+    }
+
     stream = std::ifstream(infile);
     stream = std::ifstream(infile);
 
@@ -198,7 +256,7 @@ int main(int argc, char *const *argv) {
 
     stream.close();
 
-    ISOBMFF::Error err = parser.Parse(path);
+    ISOBMFF::Error err = batch ? errors[i] : parser.Parse(path);
     if (err) {
       std::cerr << "Parse error: " << err.GetMessage() << std::endl;
 
@@ -209,7 +267,9 @@ int main(int argc, char *const *argv) {
       return EXIT_FAILURE;
     }
 
-    if (options->analyze_flag) {
+    if (options->analyze_flag && batch) {
+      std::cout << dumps[i] << std::endl << std::endl;
+    } else if (options->analyze_flag) {
       std::cout << *(parser.GetFile()) << std::endl << std::endl;
     }
   }